@@ -0,0 +1,143 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <tuple>
+
+#include "constants.hpp"
+
+typedef uint32_t NodeIndex;
+const NodeIndex NULL_NODE = UINT32_MAX;
+
+/**
+ * A fixed capacity pool of search tree nodes. Nodes are bump allocated in blocks (all children of a node at once) so
+ * siblings are contiguous and can be referred to by the index of the first child and a count. Nothing is freed
+ * individually; the whole arena is released in O(1) by resetting the bump pointer. Nodes are never destructed, so the
+ * node type must be trivially destructible.
+ *
+ * Each of the Columns types adds an array indexed by node alongside the nodes (structure of arrays), so a field of all
+ * children of a node can be read as one contiguous run. Columns are not initialised by the arena.
+ */
+template<typename Node, typename... Columns>
+class NodeArena {
+	public:
+		/**
+		 * @brief Resize the arena, discarding all current nodes.
+		 *
+		 * @param bytes Memory budget of the arena in bytes. The arena always holds at least one full expansion of the
+		 * root.
+		 */
+		void resize(const size_t bytes) {
+			this->nodes.reset();
+			this->columns = {};
+			this->capacity = std::max(bytes / NODE_SIZE, static_cast<size_t>(MAX_MOVES + 1));
+			this->nodes = std::make_unique<Node[]>(this->capacity);
+			this->columns = { std::make_unique<Columns[]>(this->capacity)... };
+			clear();
+		}
+
+		/**
+		 * @brief Release every node in the arena.
+		 */
+		inline void clear() {
+			this->used.store(0, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Reserve a contiguous block of nodes. The nodes and their columns must be initialised by the caller.
+		 *
+		 * @param count Number of nodes to reserve.
+		 * @return Index of the first node of the block, or NULL_NODE if the arena is full.
+		 */
+		inline NodeIndex allocate(const size_t count) {
+			const size_t first = this->used.fetch_add(count, std::memory_order_relaxed);
+			if (first + count > this->capacity) return NULL_NODE;
+			return static_cast<NodeIndex>(first);
+		}
+
+		/**
+		 * @brief Release every node from an index on, keeping the nodes before it.
+		 *
+		 * @param count Number of nodes to keep.
+		 */
+		inline void shrink(const size_t count) {
+			this->used.store(std::min(count, this->capacity), std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Check if no nodes have been allocated since the arena was last cleared.
+		 *
+		 * @return True if the arena is empty, else false.
+		 */
+		inline bool empty() const {
+			return this->used.load(std::memory_order_relaxed) == 0;
+		}
+
+		/**
+		 * @brief Copy a node and its columns to another index. Used to compact the arena. Anything referring to the
+		 * node by index must be updated by the caller.
+		 *
+		 * @param from Index of the node.
+		 * @param to Index to copy the node to.
+		 */
+		inline void relocate(const NodeIndex from, const NodeIndex to) {
+			this->nodes[to] = this->nodes[from];
+			std::apply([from, to](auto&... column) { ((column[to] = column[from]), ...); }, this->columns);
+		}
+
+		inline Node& operator[](const NodeIndex index) const {
+			return this->nodes[index];
+		}
+
+		/**
+		 * @brief Get a column array.
+		 *
+		 * @tparam Column Position of the column in the Columns types.
+		 * @return Pointer to the first element of the column.
+		 */
+		template<size_t Column>
+		inline auto column() const {
+			return std::get<Column>(this->columns).get();
+		}
+
+		/**
+		 * @brief Get the index of a node in the arena.
+		 *
+		 * @param node Node that was allocated from this arena.
+		 * @return Index of the node.
+		 */
+		inline NodeIndex indexOf(const Node* node) const {
+			return static_cast<NodeIndex>(node - this->nodes.get());
+		}
+
+		/**
+		 * @brief Get the occupancy of the arena.
+		 *
+		 * @return Occupancy in permille, as reported by the UCI "hashfull" info.
+		 */
+		inline uint hashfull() const {
+			const size_t used = std::min(this->used.load(std::memory_order_relaxed), this->capacity);
+			return used * 1000 / this->capacity;
+		}
+
+		/**
+		 * @brief Get the size of the arena.
+		 *
+		 * @return Size of the arena in bytes.
+		 */
+		inline size_t getSize() const {
+			return this->capacity * NODE_SIZE;
+		}
+
+	private:
+		static constexpr size_t NODE_SIZE = (sizeof(Node) + ... + sizeof(Columns));
+
+		std::unique_ptr<Node[]> nodes;
+		std::tuple<std::unique_ptr<Columns[]>...> columns;
+		size_t capacity = 0;
+		std::atomic<size_t> used = 0;
+};
+
+#endif
@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 #include <array>
+#include <span>
 
 const std::string NAME = "Sicario";
 const std::string CODENAME = "Iteration-8";
@@ -19,21 +20,36 @@ const std::string CHESS_PROGRAMMING = "www.chessprogramming.org";
 const std::string STOCKFISH = "Stockfish";
 const std::string BLUE_FEVER_SOFT = "bluefeversoft";
 const std::string STANDARD_GAME = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+const std::vector<std::string> BENCH_POSITIONS = {
+	STANDARD_GAME,
+	"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+	"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+	"r2q1rk1/pP1p2pp/Q4n2/bbp1p3/Np6/1B3NBn/pPPP1PPP/R3K2R b KQ - 0 1",
+	"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+};
 
 const uint PLAYER_COUNT = 2;
 const uint SQUARE_COUNT = 64;
 const uint FILE_COUNT = 8;
 const uint RANK_COUNT = 8;
 const uint PIECE_TYPE_COUNT = 12;
+const uint BASE_PIECE_TYPE_COUNT = 6;
 const uint CASTLING_OPTIONS = 4;
 const uint CASTLING_COMBOS = 16;
+const uint PROMOTION_OPTIONS = 4;
 const uint DESTINATION_SHIFT = 6;
 const uint MOVE_TYPE_SHIFT = 12;
 const uint PROMOTION_SHIFT = 14;
 const uint KING_INDEX = 0;
 const uint MOVESET_SIZE = 32;
 const uint DEFAULT_HASH_SIZE = 16;
+const uint TT_HASH_DIVISOR = 4;
 const uint MAX_PIECE_COUNT = 10;
+const uint MAX_MOVES = 256;
+const int MAX_PLY = 128;
+const uint HISTORY_CAPACITY = 1024;
+const uint DEFAULT_BENCH_TIME = 1000;
+const size_t CACHE_LINE_SIZE = 64;
 const uint FEN_BOARD_INDEX = 0;
 const uint FEN_MOVE_INDEX = 1;
 const uint FEN_CASTLING_INDEX = 2;
@@ -57,7 +73,7 @@ typedef uint16_t Move;
 typedef std::vector<Move> MoveVector;
 typedef std::vector<MoveVector> MoveFamily;
 typedef std::array<MoveFamily, SQUARE_COUNT> MoveFamilies;
-typedef std::vector<Move> const* MoveSet;
+typedef std::span<const Move> MoveSet;
 typedef uint64_t Hash;
 typedef std::vector<Bitboard> BitboardVector;
 typedef std::array<std::vector<Bitboard>, SQUARE_COUNT> BitboardFamily;
@@ -191,6 +207,7 @@ enum UciInput {
 
 	// Custom commands to engine
 	PERFT,
+	PERFT_SUITE,
 	MOVE,
 	UNDO,
 	DISPLAY,
@@ -199,6 +216,7 @@ enum UciInput {
 	RANDOMGAME,
 	STATE,
 	OPTIONS,
+	BENCH,
 
 	// Sentinel for invalid command
 	INVALID_COMMAND
@@ -217,6 +235,11 @@ enum ConfigOption {
 	UCI_ANALYSE_MODE,
 	UCI_OPPONENT,
 	EXPAND_TIME,
+	MCTS_PARALLEL,
+	ROLLOUT_PLIES,
+	TWO_FOLD_REPETITION,
+	SEARCH_ALGORITHM,
+	EVAL_FILE,
 	CLEAR_HASH,
 
 	CONFIGS_COUNT,
@@ -2,54 +2,36 @@
 #include <x86intrin.h>
 #endif
 
+#include <algorithm>
 #include <iostream>
 #include <bitset>
-#include <random>
 #include <cassert>
 
 #include "game.hpp"
 #include "utils.hpp"
 #include "bitboard.hpp"
+#include "psqt.hpp"
 
-namespace Moves {
-	const MoveFamilies KING = computeKingMoves();
-	const MoveFamilies ROOK = computeRookMoves();
-	const MoveFamilies BISHOP = computeBishopMoves();
-	const MoveFamilies KNIGHT = computeKnightMoves();
-	const std::array<MoveFamilies, PLAYER_COUNT> PAWN = computePawnMoves();
-	const std::array<MoveVector, CASTLING_OPTIONS> CASTLING = computeCastlingMoves();
-	const std::array<std::vector<MoveFamily>, PLAYER_COUNT> EN_PASSANT = computeEnPassantMoves();
+inline void Position::addEvaluation(const PieceType piece, const Square square) {
+	this->material += PSQT::MATERIAL_VALUES[piece];
+	this->psqt_middlegame += PSQT::MIDDLEGAME_VALUES[piece][square];
+	this->psqt_endgame += PSQT::ENDGAME_VALUES[piece][square];
+	this->phase += PSQT::PHASE_WEIGHTS[piece];
+	if (Nnue.isLoaded()) Nnue.addFeature(this->accumulator, piece, square);
 }
 
-namespace Moves::Blocks {
-	const MoveFamilies ROOK = computeRookBlockMoves();
-	const MoveFamilies BISHOP = computeBishopBlockMoves();
+inline void Position::removeEvaluation(const PieceType piece, const Square square) {
+	this->material -= PSQT::MATERIAL_VALUES[piece];
+	this->psqt_middlegame -= PSQT::MIDDLEGAME_VALUES[piece][square];
+	this->psqt_endgame -= PSQT::ENDGAME_VALUES[piece][square];
+	this->phase -= PSQT::PHASE_WEIGHTS[piece];
+	if (Nnue.isLoaded()) Nnue.removeFeature(this->accumulator, piece, square);
 }
 
-namespace Indices {
-	const IndicesFamily ROOK = computeRookReachIndices();
-	const IndicesFamily BISHOP = computeBishopReachIndices();
-}
-
-namespace Reach {
-	const BitboardFamily ROOK = computeRookReaches();
-	const BitboardFamily BISHOP = computeBishopReaches();
-}
-
-namespace KingReach {
-	const std::array<std::vector<std::vector<Square>>, SQUARE_COUNT> SQUARES = computeKingReachSquares();
-}
-
-namespace Rays {
-	const BitboardFamily LEVEL = computeLevelRays();
-	const BitboardFamily DIAGONAL = computeDiagonalRays();
-}
-
-namespace Hashes {
-	std::array<std::array<Hash, SQUARE_COUNT>, PIECE_TYPE_COUNT> PIECES = generatePieceHashes();
-	Hash TURN = generateTurnHash();
-	std::array<Hash, CASTLING_COMBOS> CASTLING = generateCastlingHash();
-	std::array<Hash, FILE_COUNT> EN_PASSANT = generateEnPassantHash();
+inline void Position::moveEvaluation(const PieceType piece, const Square start, const Square end) {
+	this->psqt_middlegame += PSQT::MIDDLEGAME_VALUES[piece][end] - PSQT::MIDDLEGAME_VALUES[piece][start];
+	this->psqt_endgame += PSQT::ENDGAME_VALUES[piece][end] - PSQT::ENDGAME_VALUES[piece][start];
+	if (Nnue.isLoaded()) Nnue.moveFeature(this->accumulator, piece, start, end);
 }
 
 template <PieceType T>
@@ -62,6 +44,7 @@ void Position::movePiece(const Square start, const Square end) {
 	}
 	this->pieces[start] = NO_PIECE;
 	this->pieces[end] = T;
+	moveEvaluation(T, start, end);
 }
 
 template<>
@@ -69,6 +52,7 @@ void Position::movePiece<W_KING>(const Square start, const Square end) {
 	this->piece_list[W_KING][KING_INDEX] = end;
 	this->pieces[start] = NO_PIECE;
 	this->pieces[end] = W_KING;
+	moveEvaluation(W_KING, start, end);
 }
 
 template<>
@@ -76,6 +60,7 @@ void Position::movePiece<B_KING>(const Square start, const Square end) {
 	this->piece_list[B_KING][KING_INDEX] = end;
 	this->pieces[start] = NO_PIECE;
 	this->pieces[end] = B_KING;
+	moveEvaluation(B_KING, start, end);
 }
 
 template<>
@@ -155,6 +140,7 @@ void Position::removePiece(const Square square) {
 		}
 	}
 	this->pieces[square] = NO_PIECE;
+	removeEvaluation(T, square);
 }
 
 template <PieceType T>
@@ -163,6 +149,7 @@ void Position::addPiece(const Square square) {
 	assert(this->pieces[square] == NO_PIECE);
 	this->piece_list[T][this->piece_index[T]++] = square;
 	this->pieces[square] = T;
+	addEvaluation(T, square);
 }
 
 template <Square KS, Square KE, Square RS, Square RE, PieceType K, PieceType R>
@@ -282,7 +269,6 @@ void Position::makeMove<NORMAL>(const Move move) {
 
 	// Update non-position information
 	updateCastling(start(move), end(move));
-	updateEnPassant(false);
 	updateFullmove();
 	updateHalfmove(piece_captured != NO_PIECE || piece_moved == W_PAWN || piece_moved == B_PAWN);
 	updateTurn();
@@ -355,7 +341,7 @@ void Position::makeMove<EN_PASSANT>(const Move move) {
 
 	// Update hash
 	this->hash ^= Hashes::PIECES[getPieceType<PAWN>()][start(move)] ^ Hashes::PIECES[getPieceType<PAWN>()][end(move)] ^
-			Hashes::PIECES[takenPawnSquare][takenPawnSquare];
+			Hashes::PIECES[this->turn == WHITE ? B_PAWN : W_PAWN][takenPawnSquare];
 
 	// Update non-position information
 	updateEnPassant(true);
@@ -390,11 +376,12 @@ void Position::makeMove<CASTLING>(const Move move) {
 	}
 }
 
+#ifndef COPY_MAKE
 template<>
 void Position::undoMove<NORMAL>() {
 	// Change game history
 	History prev = this->history.back();
-	this->history.pop_back();
+	this->history.pop();
 
 	// Revert non-position information
 	this->turn = !this->turn;
@@ -430,8 +417,8 @@ void Position::undoMove<NORMAL>() {
 template<>
 void Position::undoMove<PROMOTION>() {
 	// Change game history
-	History prev = history.back();
-	this->history.pop_back();
+	History prev = this->history.back();
+	this->history.pop();
 
 	// Revert non-position information
 	this->turn = !this->turn;
@@ -487,8 +474,8 @@ void Position::undoMove<PROMOTION>() {
 template<>
 void Position::undoMove<EN_PASSANT>() {
 	// Change game history
-	History prev = history.back();
-	this->history.pop_back();
+	History prev = this->history.back();
+	this->history.pop();
 
 	// Revert non-position information
 	this->turn = !this->turn;
@@ -516,8 +503,8 @@ void Position::undoMove<EN_PASSANT>() {
 template<>
 void Position::undoMove<CASTLING>() {
 	// Change game history
-	History prev = history.back();
-	this->history.pop_back();
+	History prev = this->history.back();
+	this->history.pop();
 
 	// Revert non-position information
 	this->turn = !this->turn;
@@ -556,9 +543,11 @@ void Position::undoMove<CASTLING>() {
 			movePiece<B_KING>(end(prev.move), start(prev.move));
 	this->turn == WHITE ? movePiece<W_ROOK>(rook_end, rook_start) : movePiece<B_ROOK>(rook_end, rook_start);
 }
+#endif
 
 void Position::updateTurn() {
 	this->turn = !this->turn;
+	this->hash ^= Hashes::TURN;
 }
 
 void Position::updateCastling(const Square start, const Square end) {
@@ -615,7 +604,6 @@ void Position::updateHalfmove(const bool zero) {
 void Position::updateFullmove() {
 	if (this->turn == BLACK) {
 		this->fullmove++;
-		this->hash ^= Hashes::TURN;
 	}
 }
 
@@ -696,7 +684,10 @@ void Position::movePieceAndUpdateBitboard(const PieceType piece, const Square st
 }
 
 void Position::saveHistory(const Move move) {
-	this->history.push_back({
+	#ifdef COPY_MAKE
+	this->history.push({ *this, move });
+	#else
+	this->history.push({
 		this->castling,
 		this->en_passant,
 		this->halfmove,
@@ -704,9 +695,10 @@ void Position::saveHistory(const Move move) {
 		move,
 		this->pieces[end(move)],
 	});
+	#endif
 }
 
-void Position::processMakeMove(const Move move, const bool hash) {
+void Position::processMakeMove(const Move move) {
 	if (move == NULL_MOVE) return;
 	saveHistory(move);
 	switch (type(move)) {
@@ -723,7 +715,38 @@ void Position::processMakeMove(const Move move, const bool hash) {
 			makeMove<PROMOTION>(move);
 			break;
 	}
-	if (hash) incrementPositionCounter();
+}
+
+void Position::copyBoard(const Position& position) {
+	static_cast<BoardState&>(*this) = static_cast<const BoardState&>(position);
+	if (Nnue.isLoaded()) this->accumulator = position.accumulator;
+	this->history.clear();
+}
+
+void Position::refreshAccumulator() {
+	if (Nnue.isLoaded()) Nnue.refresh(this->accumulator, this->pieces);
+}
+
+void Position::setSearchRoot(const bool twoFold) {
+	this->searchRoot = this->history.height();
+	this->twoFoldRepetition = twoFold;
+}
+
+void Position::playMove(const Move move) {
+	switch (type(move)) {
+		case NORMAL:
+			makeMove<NORMAL>(move);
+			break;
+		case CASTLING:
+			makeMove<CASTLING>(move);
+			break;
+		case EN_PASSANT:
+			makeMove<EN_PASSANT>(move);
+			break;
+		default:
+			makeMove<PROMOTION>(move);
+			break;
+	}
 }
 
 void Position::addToPromotionBitboard(const Move move) {
@@ -887,19 +910,94 @@ void Position::setPinAndCheckRayBitboards() {
 	}
 }
 
+#ifdef FLAT_MOVE_LIST
+/**
+ * Receives the move sets of a position and copies their moves into the moves array of a MoveList.
+ */
+struct FlatMoveSink {
+	uint& moveCount;
+	Move* moves;
+
+	template<typename Lookup>
+	inline void add(const uint, Lookup lookup) {
+		const MoveSet set = lookup();
+		std::copy(set.begin(), set.end(), this->moves + this->moveCount);
+		this->moveCount += set.size();
+	}
+};
+#else
+/**
+ * Receives the move sets of a position and stores them in the pos_moves array of a MoveList.
+ */
+struct MoveSetSink {
+	uint& moves_index;
+	MoveSet* pos_moves;
+
+	template<typename Lookup>
+	inline void add(const uint, Lookup lookup) {
+		this->pos_moves[this->moves_index++] = lookup();
+	}
+};
+#endif
+
+/**
+ * Receives the move sets of a position and only counts their moves, so the table lookups are never made.
+ */
+struct MoveCountSink {
+	uint64_t count = 0;
+
+	template<typename Lookup>
+	inline void add(const uint moves, Lookup) {
+		this->count += moves;
+	}
+};
+
+/**
+ * Receives move sets of a position and records whether one of them holds a given move.
+ */
+struct MoveFindSink {
+	const Move move;
+	bool found = false;
+
+	template<typename Lookup>
+	inline void add(const uint, Lookup lookup) {
+		const MoveSet set = lookup();
+		this->found |= std::find(set.begin(), set.end(), this->move) != set.end();
+	}
+};
+
+#ifdef FLAT_MOVE_LIST
+void Position::getMoves(uint& moveCount, Move moves[MAX_MOVES]) {
+	FlatMoveSink sink{moveCount, moves};
+	generateMoves(sink);
+}
+#else
 void Position::getMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) {
+	MoveSetSink sink{moves_index, pos_moves};
+	generateMoves(sink);
+}
+#endif
+
+uint64_t Position::countMoves() {
+	MoveCountSink sink;
+	generateMoves(sink);
+	return sink.count;
+}
+
+template<typename Sink>
+void Position::generateMoves(Sink& sink) {
 	setCheckers();
 	if (inCheck()) {
 		if (inDoubleCheck()) {
-			getKingMoves(moves_index, pos_moves);
+			getKingMoves(sink);
 			return;
 		}
 		setPinAndCheckRayBitboards();
-		getCheckMoves(moves_index, pos_moves);
+		getCheckMoves(sink);
 		return;
 	}
 	setPinAndCheckRayBitboards();
-	getNormalMoves(moves_index, pos_moves);
+	getNormalMoves(sink);
 }
 
 void Position::parseFen(const std::string fen) {
@@ -942,7 +1040,36 @@ void Position::parseFen(const std::string fen) {
 	parseFenMoves(parts[FEN_HALFMOVE_INDEX], parts[FEN_FULLMOVE_INDEX]);
 
 	initialiseHash();
-	incrementPositionCounter();
+}
+
+std::string Position::getFen() const {
+	const char pieceChars[] = "kKQRBNPqrbnp"; // Indexed by PieceType.
+	std::string fen;
+	for (int rank = RANK_8; rank >= RANK_1; rank--) {
+		int empty = 0;
+		for (int file = FILE_A; file <= FILE_H; file++) {
+			const PieceType piece = this->pieces[RANK_COUNT * rank + file];
+			if (piece == NO_PIECE) {
+				empty++;
+				continue;
+			}
+			if (empty > 0) fen += std::to_string(empty);
+			empty = 0;
+			fen += pieceChars[piece];
+		}
+		if (empty > 0) fen += std::to_string(empty);
+		if (rank != RANK_1) fen += '/';
+	}
+
+	fen += this->turn == WHITE ? " w " : " b ";
+	if (this->castling & (1 << WKSC)) fen += 'K';
+	if (this->castling & (1 << WQSC)) fen += 'Q';
+	if (this->castling & (1 << BKSC)) fen += 'k';
+	if (this->castling & (1 << BQSC)) fen += 'q';
+	if (this->castling == 0) fen += '-';
+	fen += ' ' + (this->en_passant == NONE ? "-" : squareName[this->en_passant]);
+	fen += ' ' + std::to_string(this->halfmove) + ' ' + std::to_string(this->fullmove);
+	return fen;
 }
 
 void Position::resetPosition() {
@@ -980,9 +1107,17 @@ void Position::resetPosition() {
 	this->light_bishop_cnt = 0;
 	this->dark_bishop_cnt = 0;
 
+	// Evaluation terms
+	this->material = 0;
+	this->psqt_middlegame = 0;
+	this->psqt_endgame = 0;
+	this->phase = 0;
+	refreshAccumulator();
+
 	// History
 	this->history.clear();
-	this->positionCounts.clear();
+	this->searchRoot = 0;
+	this->twoFoldRepetition = false;
 	this->hash = ZERO_BB;
 }
 
@@ -1037,6 +1172,7 @@ void Position::addFenPiece(Bitboard& pieceBB, const PieceType piece, const Squar
 	this->piece_list[piece][this->piece_index[piece]] = square;
 	this->piece_index[piece]++;
 	this->pieces[square] = piece;
+	addEvaluation(piece, square);
 }
 
 void Position::parseFenChar(char piece, Rank rank, File file) {
@@ -1104,11 +1240,8 @@ bool Position::insufficientMaterial() const {
 	return false;
 }
 
-inline bool Position::inCheck() const {
-	return this->checkers;
-}
-
-void Position::getKingMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const {
+template<typename Sink>
+void Position::getKingMoves(Sink& sink) const {
 	Bitboard reachBB = Masks::KING[getKingSquare()] & ~this->sides[this->turn];
 
 	if (reachBB == ZERO_BB) return;
@@ -1119,69 +1252,82 @@ void Position::getKingMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE])
 	}
 
 	if (reachBB == ZERO_BB) return;
-	pos_moves[moves_index++] = &Moves::KING[getKingSquare()][getKingMovesIndex(reachBB, getKingSquare())];
+	sink.add(bitCount(reachBB), [&] {
+		return Moves::KING[getKingSquare()][getKingMovesIndex(reachBB, getKingSquare())];
+	});
 }
 
-void Position::getCheckMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const {
-	getKingMoves(moves_index, pos_moves);
-	getQueenCheckedMoves(moves_index, pos_moves);
-	getRookCheckedMoves(moves_index, pos_moves);
-	getBishopCheckedMoves(moves_index, pos_moves);
-	getKnightCheckedMoves(moves_index, pos_moves);
-	getPawnCheckedMoves(moves_index, pos_moves);
-	getEnPassantCheckMoves(moves_index, pos_moves);
+template<typename Sink>
+void Position::getCheckMoves(Sink& sink) const {
+	getKingMoves(sink);
+	getQueenCheckedMoves(sink);
+	getRookCheckedMoves(sink);
+	getBishopCheckedMoves(sink);
+	getKnightCheckedMoves(sink);
+	getPawnCheckedMoves(sink);
+	getEnPassantCheckMoves(sink);
 }
 
-void Position::getQueenCheckedMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const {
+template<typename Sink>
+void Position::getQueenCheckedMoves(Sink& sink) const {
 	for (uint i = 0; i < this->piece_index[getPieceType<QUEEN>()]; i++) {
 		Square queenSquare = this->piece_list[getPieceType<QUEEN>()][i];
 		if (!isPinned(queenSquare)) {
 			Bitboard reach = getRookReachBB(Masks::ROOK[queenSquare] & getPieces(), queenSquare) & this->check_rays;
-			if (reach != ZERO_BB) pos_moves[moves_index++] =
-					&Moves::Blocks::ROOK[queenSquare][getRookBlockIndex(reach, queenSquare)];
+			if (reach != ZERO_BB) sink.add(bitCount(reach), [&] {
+				return Moves::Blocks::ROOK[queenSquare][getRookBlockIndex(reach, queenSquare)];
+			});
 
 			reach = getBishopReachBB(Masks::BISHOP[queenSquare] & getPieces(), queenSquare) & this->check_rays;
-			if (reach != ZERO_BB) pos_moves[moves_index++] =
-					&Moves::Blocks::BISHOP[queenSquare][getBishopBlockIndex(reach, queenSquare)];
+			if (reach != ZERO_BB) sink.add(bitCount(reach), [&] {
+				return Moves::Blocks::BISHOP[queenSquare][getBishopBlockIndex(reach, queenSquare)];
+			});
 		}
 	}
 }
 
-void Position::getRookCheckedMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const {
+template<typename Sink>
+void Position::getRookCheckedMoves(Sink& sink) const {
 	for (uint i = 0; i < this->piece_index[getPieceType<ROOK>()]; i++) {
 		Square rookSquare = this->piece_list[getPieceType<ROOK>()][i];
 		if (!isPinned(rookSquare)) {
 			Bitboard reach = getRookReachBB(Masks::ROOK[rookSquare] & getPieces(), rookSquare) & this->check_rays;
-			if (reach != ZERO_BB) pos_moves[moves_index++] =
-					&Moves::Blocks::ROOK[rookSquare][getRookBlockIndex(reach, rookSquare)];
+			if (reach != ZERO_BB) sink.add(bitCount(reach), [&] {
+				return Moves::Blocks::ROOK[rookSquare][getRookBlockIndex(reach, rookSquare)];
+			});
 		}
 	}
 }
 
-void Position::getBishopCheckedMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const {
+template<typename Sink>
+void Position::getBishopCheckedMoves(Sink& sink) const {
 	for (uint i = 0; i < this->piece_index[getPieceType<BISHOP>()]; i++) {
 		Square bishopSquare = this->piece_list[getPieceType<BISHOP>()][i];
 		if (!isPinned(bishopSquare)) {
 			Bitboard reach = getBishopReachBB(Masks::BISHOP[bishopSquare] & getPieces(), bishopSquare) &
 					this->check_rays;
-			if (reach != ZERO_BB) pos_moves[moves_index++] =
-					&Moves::Blocks::BISHOP[bishopSquare][getBishopBlockIndex(reach, bishopSquare)];
+			if (reach != ZERO_BB) sink.add(bitCount(reach), [&] {
+				return Moves::Blocks::BISHOP[bishopSquare][getBishopBlockIndex(reach, bishopSquare)];
+			});
 		}
 	}
 }
 
-void Position::getKnightCheckedMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const {
+template<typename Sink>
+void Position::getKnightCheckedMoves(Sink& sink) const {
 	for (uint i = 0; i < this->piece_index[getPieceType<KNIGHT>()]; i++) {
 		Square knightSquare = this->piece_list[getPieceType<KNIGHT>()][i];
 		if (!isPinned(knightSquare)) {
 			Bitboard reach = Masks::KNIGHT[knightSquare] & this->check_rays;
-			if (reach != ZERO_BB) pos_moves[moves_index++] =
-					&Moves::KNIGHT[knightSquare][getKnightMovesIndex(reach, knightSquare)];
+			if (reach != ZERO_BB) sink.add(bitCount(reach), [&] {
+				return Moves::KNIGHT[knightSquare][getKnightMovesIndex(reach, knightSquare)];
+			});
 		}
 	}
 }
 
-void Position::getPawnCheckedMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const {
+template<typename Sink>
+void Position::getPawnCheckedMoves(Sink& sink) const {
 	for (uint i = 0; i < this->piece_index[getPieceType<PAWN>()]; i++) {
 		Square pawnSquare = this->piece_list[getPieceType<PAWN>()][i];
 		if (!isPinned(pawnSquare)) {
@@ -1200,8 +1346,9 @@ void Position::getPawnCheckedMoves(uint& moves_index, MoveSet pos_moves[MOVESET_
 
 			reach |= Masks::PAWN[this->turn][pawnSquare] & ~Masks::FILE[file(pawnSquare)] &
 					(this->check_rays & this->sides[!this->turn]);
-			if (reach != ZERO_BB) pos_moves[moves_index++] =
-					&Moves::PAWN[this->turn][pawnSquare][getPawnMovesIndex(reach, pawnSquare, this->turn)];
+			if (reach != ZERO_BB) sink.add(getPawnMoveCount(reach, pawnSquare), [&] {
+				return Moves::PAWN[this->turn][pawnSquare][getPawnMovesIndex(reach, pawnSquare, this->turn)];
+			});
 		}
 	}
 }
@@ -1228,88 +1375,100 @@ void Position::initialiseHash() {
 	}
 }
 
-void Position::getNormalMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const {
-	this->getKingMoves(moves_index, pos_moves);
-	this->getQueenMoves(moves_index, pos_moves);
-	this->getRookMoves(moves_index, pos_moves);
-	this->getBishopMoves(moves_index, pos_moves);
-	this->getKnightMoves(moves_index, pos_moves);
-	this->getPawnMoves(moves_index, pos_moves);
-	this->getCastlingMoves(moves_index, pos_moves);
-	this->getEnPassantMoves(moves_index, pos_moves);
+template<typename Sink>
+void Position::getNormalMoves(Sink& sink) const {
+	this->getKingMoves(sink);
+	this->getQueenMoves(sink);
+	this->getRookMoves(sink);
+	this->getBishopMoves(sink);
+	this->getKnightMoves(sink);
+	this->getPawnMoves(sink);
+	this->getCastlingMoves(sink);
+	this->getEnPassantMoves(sink);
 }
 
-void Position::getQueenMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const {
+template<typename Sink>
+void Position::getQueenMoves(Sink& sink) const {
 	for (uint i = 0; i < this->piece_index[getPieceType<QUEEN>()]; i++) {
 		Square queenSquare = this->piece_list[getPieceType<QUEEN>()][i];
 		if (isPinnedByBishop(queenSquare)) {
-			getBishopPinMoves(moves_index, pos_moves, queenSquare);
+			getBishopPinMoves(sink, queenSquare);
 		} else if (isPinnedByRook(queenSquare)) {
-			getRookPinMoves(moves_index, pos_moves, queenSquare);
+			getRookPinMoves(sink, queenSquare);
 		} else {
 			Bitboard reach = getBishopReachBB(Masks::BISHOP[queenSquare] & getPieces(), queenSquare) &
 					~this->sides[this->turn];
-			if (reach != ZERO_BB) pos_moves[moves_index++] =
-					&Moves::BISHOP[queenSquare][getBishopMovesIndex(reach, queenSquare)];
+			if (reach != ZERO_BB) sink.add(bitCount(reach), [&] {
+				return Moves::BISHOP[queenSquare][getBishopMovesIndex(reach, queenSquare)];
+			});
 
 			reach = getRookReachBB(Masks::ROOK[queenSquare] & getPieces(), queenSquare) & ~this->sides[this->turn];
-			if (reach != ZERO_BB) pos_moves[moves_index++] =
-					&Moves::ROOK[queenSquare][getRookMovesIndex(reach, queenSquare)];
+			if (reach != ZERO_BB) sink.add(bitCount(reach), [&] {
+				return Moves::ROOK[queenSquare][getRookMovesIndex(reach, queenSquare)];
+			});
 		}
 	}
 }
 
-void Position::getRookMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const {
+template<typename Sink>
+void Position::getRookMoves(Sink& sink) const {
 	for (uint i = 0; i < this->piece_index[getPieceType<ROOK>()]; i++) {
 		Square rookSquare = this->piece_list[getPieceType<ROOK>()][i];
 		if (isPinnedByBishop(rookSquare)) {
 			continue;
 		} else if (isPinnedByRook(rookSquare)) {
-			getRookPinMoves(moves_index, pos_moves, rookSquare);
+			getRookPinMoves(sink, rookSquare);
 		} else {
 			Bitboard reach = getRookReachBB(Masks::ROOK[rookSquare] & getPieces(), rookSquare) &
 					~this->sides[this->turn];
-			if (reach != ZERO_BB) pos_moves[moves_index++] =
-					&Moves::ROOK[rookSquare][getRookMovesIndex(reach, rookSquare)];
+			if (reach != ZERO_BB) sink.add(bitCount(reach), [&] {
+				return Moves::ROOK[rookSquare][getRookMovesIndex(reach, rookSquare)];
+			});
 		}
 	}
 }
 
-void Position::getBishopMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const {
+template<typename Sink>
+void Position::getBishopMoves(Sink& sink) const {
 	for (uint i = 0; i < this->piece_index[getPieceType<BISHOP>()]; i++) {
 		Square bishopSquare = this->piece_list[getPieceType<BISHOP>()][i];
 		if (isPinnedByBishop(bishopSquare)) {
-			getBishopPinMoves(moves_index, pos_moves, bishopSquare);
+			getBishopPinMoves(sink, bishopSquare);
 		} else if (isPinnedByRook(bishopSquare)) {
 			continue;
 		} else {
 			Bitboard reach = getBishopReachBB(Masks::BISHOP[bishopSquare] & getPieces(), bishopSquare) &
 					~this->sides[this->turn];
-			if (reach != ZERO_BB) pos_moves[moves_index++] =
-					&Moves::BISHOP[bishopSquare][getBishopMovesIndex(reach, bishopSquare)];
+			if (reach != ZERO_BB) sink.add(bitCount(reach), [&] {
+				return Moves::BISHOP[bishopSquare][getBishopMovesIndex(reach, bishopSquare)];
+			});
 		}
 	}
 }
 
-void Position::getKnightMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const {
+template<typename Sink>
+void Position::getKnightMoves(Sink& sink) const {
 	for (uint i = 0; i < this->piece_index[getPieceType<KNIGHT>()]; i++) {
 		Square knightSquare = this->piece_list[getPieceType<KNIGHT>()][i];
 		if (!isPinnedByBishop(knightSquare) && !isPinnedByRook(knightSquare)) {
 			Bitboard reach = Masks::KNIGHT[knightSquare] & ~this->sides[this->turn];
-			if (reach != ZERO_BB) pos_moves[moves_index++] =
-					&Moves::KNIGHT[knightSquare][getKnightMovesIndex(reach, knightSquare)];
+			if (reach != ZERO_BB) sink.add(bitCount(reach), [&] {
+				return Moves::KNIGHT[knightSquare][getKnightMovesIndex(reach, knightSquare)];
+			});
 		}
 	}
 }
 
-void Position::getPawnMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const {
+template<typename Sink>
+void Position::getPawnMoves(Sink& sink) const {
 	for (uint i = 0; i < this->piece_index[getPieceType<PAWN>()]; i++) {
 		Square pawnSquare = this->piece_list[getPieceType<PAWN>()][i];
 		if (isPinnedByBishop(pawnSquare)) {
 			Bitboard reach = (Masks::PAWN[this->turn][pawnSquare] & ~Masks::FILE[file(pawnSquare)]);
 			reach &= this->bishop_pins & (this->sides[!this->turn] & (this->queens | this->bishops));
-			if (reach != ZERO_BB) pos_moves[moves_index++] =
-					&Moves::PAWN[this->turn][pawnSquare][getPawnMovesIndex(reach, pawnSquare, this->turn)];
+			if (reach != ZERO_BB) sink.add(getPawnMoveCount(reach, pawnSquare), [&] {
+				return Moves::PAWN[this->turn][pawnSquare][getPawnMovesIndex(reach, pawnSquare, this->turn)];
+			});
 		} else if (isPawnPinnedByRookHorizontally(pawnSquare)) {
 			continue; // Can't move if horizontally pinned to king.
 		} else {
@@ -1328,12 +1487,18 @@ void Position::getPawnMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE])
 				}
 			}
 
-			if (reach != ZERO_BB) pos_moves[moves_index++] =
-					&Moves::PAWN[this->turn][pawnSquare][getPawnMovesIndex(reach, pawnSquare, this->turn)];
+			if (reach != ZERO_BB) sink.add(getPawnMoveCount(reach, pawnSquare), [&] {
+				return Moves::PAWN[this->turn][pawnSquare][getPawnMovesIndex(reach, pawnSquare, this->turn)];
+			});
 		}
 	}
 }
 
+inline uint Position::getPawnMoveCount(const Bitboard reach, const Square square) const {
+	const Rank promotionRank = this->turn == WHITE ? RANK_7 : RANK_2;
+	return bitCount(reach) * (rank(square) == promotionRank ? PROMOTION_OPTIONS : 1);
+}
+
 inline Bitboard Position::getRookReachBB(const Bitboard occupancy, const Square square) const {
 	return Reach::ROOK[square][Indices::ROOK[square][getRookReachIndex(occupancy, square)]];
 }
@@ -1342,54 +1507,62 @@ inline Bitboard Position::getBishopReachBB(const Bitboard occupancy, const Squar
 	return Reach::BISHOP[square][Indices::BISHOP[square][getBishopReachIndex(occupancy, square)]];
 }
 
-void Position::getBishopPinMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE], const Square square) const {
+template<typename Sink>
+void Position::getBishopPinMoves(Sink& sink, const Square square) const {
 	Bitboard reach = this->bishop_pins & ~(ONE_BB << square) &
 			getBishopReachBB(Masks::BISHOP[square] & getPieces(), square);
 	if (reach == ZERO_BB) return;
-	pos_moves[moves_index++] = &Moves::BISHOP[square][getBishopMovesIndex(reach, square)];
+	sink.add(bitCount(reach), [&] {
+		return Moves::BISHOP[square][getBishopMovesIndex(reach, square)];
+	});
 }
 
-void Position::getRookPinMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE], const Square square) const {
+template<typename Sink>
+void Position::getRookPinMoves(Sink& sink, const Square square) const {
 	Bitboard reach = this->rook_pins & ~(ONE_BB << square) & getRookReachBB(Masks::ROOK[square] & getPieces(), square);
 	if (reach == ZERO_BB) return;
-	pos_moves[moves_index++] = &Moves::ROOK[square][getRookMovesIndex(reach, square)];
+	sink.add(bitCount(reach), [&] {
+		return Moves::ROOK[square][getRookMovesIndex(reach, square)];
+	});
 }
 
 Bitboard Position::isOccupied(const Square square) const {
 	return getPieces() & (ONE_BB << square);
 }
 
-void Position::getCastlingMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const {
+template<typename Sink>
+void Position::getCastlingMoves(Sink& sink) const {
 	if (this->turn) {
 		if (this->castling & (1 << WKSC)) {
 			if (!isOccupied(F1) && !isOccupied(G1) && !isAttacked(F1, !this->turn) && !isAttacked(G1, !this->turn)) {
-				pos_moves[moves_index++] = &Moves::CASTLING[WKSC];
+				sink.add(1, [] { return MoveSet(Moves::CASTLING[WKSC]); });
 			}
 		}
 
 		if (this->castling & (1 << WQSC)) {
 			if (!isOccupied(D1) && !isOccupied(C1) && !isOccupied(B1) && !isAttacked(D1, !this->turn) &&
 					!isAttacked(C1, !this->turn)) {
-				pos_moves[moves_index++] = &Moves::CASTLING[WQSC];
+				sink.add(1, [] { return MoveSet(Moves::CASTLING[WQSC]); });
 			}
 		}
 	} else {
 		if (this->castling & (1 << BKSC)) {
 			if (!isOccupied(F8) && !isOccupied(G8) && !isAttacked(F8, !this->turn) && !isAttacked(G8, !this->turn)) {
-				pos_moves[moves_index++] = &Moves::CASTLING[BKSC];
+				sink.add(1, [] { return MoveSet(Moves::CASTLING[BKSC]); });
 			}
 		}
 
 		if (this->castling & (1 << BQSC)) {
 			if (!isOccupied(C8) && !isOccupied(B8) && !isOccupied(D8) && !isAttacked(D8, !this->turn) &&
 					!isAttacked(C8, !this->turn)) {
-				pos_moves[moves_index++] = &Moves::CASTLING[BQSC];
+				sink.add(1, [] { return MoveSet(Moves::CASTLING[BQSC]); });
 			}
 		}
 	}
 }
 
-void Position::getEnPassantMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const {
+template<typename Sink>
+void Position::getEnPassantMoves(Sink& sink) const {
 	if (this->en_passant) {
 		std::vector<Square> pawnSquares;
 		if (file(this->en_passant) != FILE_A)
@@ -1405,14 +1578,17 @@ void Position::getEnPassantMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SI
 			if (attackPawn && (!pinnedByBishop || (pinnedByBishop && enPassantPinned)) && !pinnedByRook) {
 				bool pinned = oneBitSet(getPieces() & rook_ep_pins & ~(ONE_BB << square | ONE_BB << (this->en_passant +
 						(this->turn == WHITE ? S : N))));
-				if (!pinned) pos_moves[moves_index++] = &Moves::EN_PASSANT[this->turn][file(this->en_passant)]
-						[file(square) < file(this->en_passant) ? 0 : 1];
+				if (!pinned) sink.add(1, [&] {
+					return MoveSet(Moves::EN_PASSANT[this->turn][file(this->en_passant)]
+							[file(square) < file(this->en_passant) ? 0 : 1]);
+				});
 			}
 		}
 	}
 }
 
-void Position::getEnPassantCheckMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const {
+template<typename Sink>
+void Position::getEnPassantCheckMoves(Sink& sink) const {
 	if (this->en_passant && (this->checkers & this->pawns)) {
 		std::vector<Square> pawnSquares;
 		if (file(this->en_passant) != FILE_A) pawnSquares.push_back(this->en_passant + (this->turn == WHITE ? SW : NW));
@@ -1422,8 +1598,10 @@ void Position::getEnPassantCheckMoves(uint& moves_index, MoveSet pos_moves[MOVES
 					(isPinnedByBishop(square) && isPinnedByBishop(this->en_passant))) && !isPinnedByRook(square)) {
 				bool pinned = oneBitSet(getPieces() & this->rook_ep_pins & ~(ONE_BB << square |
 						ONE_BB << (this->en_passant + (this->turn == WHITE ? S : N))));
-				if (!pinned) pos_moves[moves_index++] = &Moves::EN_PASSANT[turn][file(this->en_passant)]
-						[file(square) < file(this->en_passant) ? 0 : 1];
+				if (!pinned) sink.add(1, [&] {
+					return MoveSet(Moves::EN_PASSANT[this->turn][file(this->en_passant)]
+							[file(square) < file(this->en_passant) ? 0 : 1]);
+				});
 			}
 		}
 	}
@@ -1437,21 +1615,37 @@ inline bool Position::inDoubleCheck() const {
 	#endif
 }
 
-bool Position::isThreeFoldRep() const {
-	auto val = this->positionCounts.find(this->hash);
-	return val != this->positionCounts.end() && val->second >= 3;
+bool Position::isRepetition() const {
+	// Positions before the last capture or pawn move can not repeat, and only positions with the same side to move
+	// can be equal.
+	const size_t reversible = std::min(static_cast<size_t>(this->halfmove), this->history.size());
+	const size_t sinceRoot = this->history.height() - this->searchRoot;
+	uint occurrences = 1;
+	for (size_t ago = 2; ago <= reversible; ago += 2) {
+		if (this->history.fromBack(ago - 1).hash != this->hash) continue;
+		if (this->twoFoldRepetition && ago < sinceRoot) return true;
+		if (++occurrences == 3) return true;
+	}
+	return false;
 }
 
 ExitCode Position::isEOG(MoveList& move_list) const {
-	if (isThreeFoldRep()) return THREE_FOLD_REPETITION;
+	if (isRepetition()) return THREE_FOLD_REPETITION;
+	return isEOGIgnoringRepetition(move_list);
+}
 
+bool Position::isDrawn() const {
+	return this->halfmove >= 100 || insufficientMaterial() || isRepetition();
+}
+
+ExitCode Position::isEOGIgnoringRepetition(MoveList& move_list) const {
 	if (this->halfmove == 100) return FIFTY_MOVES_RULE;
 
 	if (insufficientMaterial()) return INSUFFICIENT_MATERIAL;
 
-	if (move_list.moves_index == 0 && !inCheck()) return STALEMATE;
+	if (move_list.empty() && !inCheck()) return STALEMATE;
 
-	if (move_list.moves_index == 0 && inCheck()) {
+	if (move_list.empty() && inCheck()) {
 		if (this->turn == WHITE) return BLACK_WINS;
 		return WHITE_WINS;
 	}
@@ -1471,11 +1665,73 @@ Bitboard Position::isAttacked(const Square square, const Player player, const bo
 	return kingBB | rooksBB | bishopsBB | knightsBB | pawnsBB;
 }
 
+bool Position::isLegal(const Move move) const {
+	const Square from = start(move);
+	const Square to = end(move);
+	if (!isOwnPiece(from) || isOwnPiece(to)) return false;
+	if (type(move) != PROMOTION && promo(move) != pKNIGHT) return false;
+
+	if (type(move) == CASTLING) {
+		// The castling moves are never generated in check, and the squares the king crosses are checked as usual.
+		if (isAttacked(getKingSquare(), !this->turn)) return false;
+		MoveFindSink sink{move};
+		getCastlingMoves(sink);
+		return sink.found;
+	}
+
+	const PieceType piece = this->pieces[from];
+	const Bitboard toBB = ONE_BB << to;
+	if (piece == getPieceType<KING>())
+		return type(move) == NORMAL && (Masks::KING[from] & toBB) && !isAttacked(to, !this->turn, true);
+
+	// The piece must reach the end square, and only pawns reaching the last rank promote.
+	Bitboard captured = this->sides[!this->turn] & toBB;
+	Bitboard reach = ZERO_BB;
+	if (piece == getPieceType<PAWN>()) {
+		const Rank promotionRank = this->turn == WHITE ? RANK_7 : RANK_2;
+		if ((rank(from) == promotionRank) != (type(move) == PROMOTION)) return false;
+
+		const Bitboard attacks = Masks::PAWN[this->turn][from] & ~Masks::FILE[file(from)];
+		if (type(move) == EN_PASSANT) {
+			if (to != this->en_passant || !(attacks & toBB)) return false;
+			captured = ONE_BB << (to + (this->turn == WHITE ? S : N));
+		} else {
+			const Direction advance = this->turn == WHITE ? N : S;
+			const Rank startRank = this->turn == WHITE ? RANK_2 : RANK_7;
+			reach = attacks & this->sides[!this->turn];
+			if (!isOccupied(from + advance)) {
+				reach |= ONE_BB << (from + advance);
+				if (rank(from) == startRank && !isOccupied(from + advance + advance))
+					reach |= ONE_BB << (from + advance + advance);
+			}
+			if (!(reach & toBB)) return false;
+		}
+	} else {
+		if (type(move) != NORMAL) return false;
+		if (piece == getPieceType<KNIGHT>()) reach = Masks::KNIGHT[from];
+		if (piece == getPieceType<ROOK>() || piece == getPieceType<QUEEN>())
+			reach |= getRookReachBB(Masks::ROOK[from] & getPieces(), from);
+		if (piece == getPieceType<BISHOP>() || piece == getPieceType<QUEEN>())
+			reach |= getBishopReachBB(Masks::BISHOP[from] & getPieces(), from);
+		if (!(reach & toBB)) return false;
+	}
+
+	// Covers pins, checks and en-passant discoveries alike: no enemy piece may attack the king once the move is made.
+	const Square king = getKingSquare();
+	const Bitboard occupancy = (getPieces() & ~(ONE_BB << from) & ~captured) | toBB;
+	const Bitboard enemies = this->sides[!this->turn] & ~captured;
+	return !((getRookReachBB(Masks::ROOK[king] & occupancy, king) & enemies & (this->queens | this->rooks)) ||
+			(getBishopReachBB(Masks::BISHOP[king] & occupancy, king) & enemies & (this->queens | this->bishops)) ||
+			(Masks::KNIGHT[king] & enemies & this->knights) ||
+			(Masks::PAWN[this->turn][king] & ~Masks::FILE[file(king)] & enemies & this->pawns));
+}
+
 void Position::removePiece(const Square square, const PieceType piece_captured) {
 	switch (piece_captured) {
 		case W_QUEEN:
 			this->queens &= ~(ONE_BB << square);
 			removePiece<W_QUEEN>(square);
+			break;
 		case B_QUEEN:
 			this->queens &= ~(ONE_BB << square);
 			removePiece<B_QUEEN>(square);
@@ -1483,6 +1739,7 @@ void Position::removePiece(const Square square, const PieceType piece_captured)
 		case W_ROOK:
 			this->rooks &= ~(ONE_BB << square);
 			removePiece<W_ROOK>(square);
+			break;
 		case B_ROOK:
 			this->rooks &= ~(ONE_BB << square);
 			removePiece<B_ROOK>(square);
@@ -1490,6 +1747,7 @@ void Position::removePiece(const Square square, const PieceType piece_captured)
 		case W_BISHOP:
 			this->bishops &= ~(ONE_BB << square);
 			removePiece<W_BISHOP>(square);
+			break;
 		case B_BISHOP:
 			this->bishops &= ~(ONE_BB << square);
 			removePiece<B_BISHOP>(square);
@@ -1497,6 +1755,7 @@ void Position::removePiece(const Square square, const PieceType piece_captured)
 		case W_KNIGHT:
 			this->knights &= ~(ONE_BB << square);
 			removePiece<W_KNIGHT>(square);
+			break;
 		case B_KNIGHT:
 			this->knights &= ~(ONE_BB << square);
 			removePiece<B_KNIGHT>(square);
@@ -1504,6 +1763,7 @@ void Position::removePiece(const Square square, const PieceType piece_captured)
 		case W_PAWN:
 			this->pawns &= ~(ONE_BB << square);
 			removePiece<W_PAWN>(square);
+			break;
 		case B_PAWN:
 			this->pawns &= ~(ONE_BB << square);
 			removePiece<B_PAWN>(square);
@@ -1514,16 +1774,22 @@ void Position::removePiece(const Square square, const PieceType piece_captured)
 	}
 }
 
-void Position::decrementPositionCounter(const Bitboard hash) {
-	auto it = this->positionCounts.find(hash);
-	if (it != this->positionCounts.end()) {
-		this->positionCounts[hash]--;
-		if (this->positionCounts[hash] == 0) this->positionCounts.erase(it);
-	}
-}
-
 void Position::processUndoMove() {
-	decrementPositionCounter(this->hash);
+	#ifdef COPY_MAKE
+	// The snapshot does not hold the accumulator, so undo the changes to the squares that the move touched.
+	if (Nnue.isLoaded()) {
+		const PieceType* previous = this->history.back().pieces;
+		for (uint square = 0; square < SQUARE_COUNT; square++) {
+			if (this->pieces[square] == previous[square]) continue;
+			if (this->pieces[square] != NO_PIECE)
+				Nnue.removeFeature(this->accumulator, this->pieces[square], static_cast<Square>(square));
+			if (previous[square] != NO_PIECE)
+				Nnue.addFeature(this->accumulator, previous[square], static_cast<Square>(square));
+		}
+	}
+	static_cast<BoardState&>(*this) = this->history.back();
+	this->history.pop();
+	#else
 	switch (type(this->history.back().move)) {
 		case NORMAL:
 			undoMove<NORMAL>();
@@ -1538,15 +1804,7 @@ void Position::processUndoMove() {
 			undoMove<PROMOTION>();
 			break;
 	}
-}
-
-void Position::incrementPositionCounter() {
-	auto record = this->positionCounts.find(this->hash);
-	if (record != this->positionCounts.end()) {
-		this->positionCounts[this->hash]++;
-	} else {
-		this->positionCounts.insert(std::pair<Bitboard, int>(this->hash, 1));
-	}
+	#endif
 }
 
 Position::Position(const std::string fen) {
@@ -1681,44 +1939,64 @@ std::string concatFEN(const std::vector<std::string> strings) {
 	return result;
 }
 
+#ifdef FLAT_MOVE_LIST
+MoveList::MoveList(Position& position) {
+	position.getMoves(this->moveCount, this->moves);
+}
+
+Move MoveList::randomMove() const {
+	return this->moves[threadPrng().bounded(this->moveCount)];
+}
+
+uint64_t MoveList::size() const {
+	return this->moveCount;
+}
+
+bool MoveList::contains(const Move targetMove) const {
+	return std::find(begin(), end(), targetMove) != end();
+}
+#else
 MoveList::MoveList(Position& position) {
 	position.getMoves(this->moves_index, this->moveSets);
 }
 
 Move MoveList::randomMove() const {
-	uint vecIndex = std::rand() % (this->moves_index);
-	uint movesIndex = std::rand() % (this->moveSets[vecIndex]->size());
-	return (*this->moveSets[vecIndex])[movesIndex];
+	// Pick the move by its index among all moves rather than picking a move set first, which would favour the moves
+	// of small sets.
+	uint index = threadPrng().bounded(size());
+	uint set = 0;
+	while (index >= this->moveSets[set].size()) index -= this->moveSets[set++].size();
+	return this->moveSets[set][index];
 }
 
 uint64_t MoveList::size() const {
 	uint64_t count = 0;
 	for (uint i = 0; i < this->moves_index; i++) {
-		count += this->moveSets[i]->size();
+		count += this->moveSets[i].size();
 	}
 	return count;
 }
 
 bool MoveList::contains(const Move targetMove) const {
 	for (uint i = 0; i < this->moves_index; i++) {
-		for (Move move : *this->moveSets[i]) {
+		for (Move move : this->moveSets[i]) {
 			if (move == targetMove) return true;
 		}
 	}
 	return false;
 }
 
-MoveList::Iterator::Iterator(int vecCnt, int i, int j, MoveSet* moves, const Move* endMove) : endAddr{endMove} {
+MoveList::Iterator::Iterator(int vecCnt, int i, MoveSet* moves, const Move* endMove) : endAddr{endMove} {
 	// End iterator
 	if (vecCnt <= 0) {
 		this->ptr = this->endAddr;
 		return;
 	}
 
-	this->ptr = &((*moves[i])[j]);
+	this->ptr = moves[i].data();
+	this->setEnd = this->ptr + moves[i].size();
 	this->vecCnt = vecCnt;
 	this->i = i;
-	this->j = j;
 	this->moves = moves;
 }
 
@@ -1731,14 +2009,11 @@ const Move* MoveList::Iterator::operator->() const {
 }
 
 MoveList::Iterator& MoveList::Iterator::operator++() { // Prefix increment
-	this->j++;
-	if (this->j >= (int) this->moves[i]->size()) {
-		this->i++;
-		this->j = 0;
-	}
+	if (++this->ptr != this->setEnd) return *this;
 
-	if (this->i != this->vecCnt) {
-		this->ptr = &(*this->moves[this->i])[this->j];
+	if (++this->i != this->vecCnt) {
+		this->ptr = this->moves[this->i].data();
+		this->setEnd = this->ptr + this->moves[this->i].size();
 	} else { // Point to end of iterator
 		this->ptr = this->endAddr;
 	}
@@ -1752,47 +2027,10 @@ MoveList::Iterator MoveList::Iterator::operator++(int) { // Postfix increment
 }
 
 MoveList::Iterator MoveList::begin() {
-	return MoveList::Iterator(this->moves_index, 0, 0, this->moveSets, this->endMove);
+	return MoveList::Iterator(this->moves_index, 0, this->moveSets, this->endMove);
 }
 
 MoveList::Iterator MoveList::end() {
-	return MoveList::Iterator(-1, -1, -1, this->moveSets, this->endMove);
-}
-
-std::array<std::array<Hash, SQUARE_COUNT>, PIECE_TYPE_COUNT> generatePieceHashes() {
-	std::default_random_engine generator(42); // Fixed random seed
-	std::uniform_int_distribution<uint64_t> distribution(0, MAX_BB);
-	std::array<std::array<Hash, SQUARE_COUNT>, PIECE_TYPE_COUNT> hashes;
-	for (uint piece = 0; piece < PIECE_TYPE_COUNT; piece++) {
-		for (Square square = A1; square <= H8; square++) {
-			hashes[piece][square] = distribution(generator);
-		}
-	}
-	return hashes;
+	return MoveList::Iterator(-1, -1, this->moveSets, this->endMove);
 }
-
-Hash generateTurnHash() {
-	std::default_random_engine generator(314); // Fixed random seed
-	std::uniform_int_distribution<uint64_t> distribution(0, MAX_BB);
-	return distribution(generator);
-}
-
-std::array<Hash, CASTLING_COMBOS> generateCastlingHash() {
-	std::default_random_engine generator(272); // Fixed random seed
-	std::uniform_int_distribution<uint64_t> distribution(0, MAX_BB);
-	std::array<Hash, CASTLING_COMBOS> hashes;
-	for (uint i = 0; i < CASTLING_COMBOS; i++) {
-		hashes[i] = distribution(generator);
-	}
-	return hashes;
-}
-
-std::array<Hash, FILE_COUNT> generateEnPassantHash() {
-	std::default_random_engine generator(162); // Fixed random seed
-	std::uniform_int_distribution<uint64_t> distribution(0, MAX_BB);
-	std::array<Hash, FILE_COUNT> hashes;
-	for (uint i = 0; i < FILE_COUNT; i++) {
-		hashes[i] = distribution(generator);
-	}
-	return hashes;
-}
\ No newline at end of file
+#endif
@@ -5,16 +5,72 @@
 
 #include "constants.hpp"
 #include "movegen.hpp"
+#include "history.hpp"
+#include "nnue.hpp"
 
 /**
  * Forward declarations.
  */
 class MoveList;
 
+/**
+ * The board state of a position, without any history. Trivially copyable so that a position can be copied cheaply
+ * for rollouts.
+ */
+struct BoardState {
+	// Non-position information
+	Player turn;
+	uint castling;
+	Square en_passant;
+	uint halfmove, fullmove;
+
+	// Bitboards
+	Bitboard sides[PLAYER_COUNT];
+	Bitboard kings, queens, rooks, bishops, knights, pawns;
+	Bitboard rook_pins;
+	Bitboard bishop_pins;
+	Bitboard check_rays;
+	Bitboard checkers;
+	Bitboard rook_ep_pins;
+
+	// Piece positions
+	uint piece_index[PIECE_TYPE_COUNT];
+	Square piece_list[PIECE_TYPE_COUNT][MAX_PIECE_COUNT];
+	PieceType pieces[SQUARE_COUNT];
+
+	// Piece counts for insufficient material checks.
+	uint piece_cnt;
+	uint knight_cnt;
+	uint bishop_cnt;
+	uint light_bishop_cnt;
+	uint dark_bishop_cnt;
+
+	// Evaluation terms in centipawns from white's perspective, updated as pieces are added, removed and moved.
+	int material;
+	int psqt_middlegame;
+	int psqt_endgame;
+	int phase;
+
+	Hash hash;
+};
+
+#ifdef COPY_MAKE
+/**
+ * Copy-make history entry. A full snapshot of the board state before the move, so undoing a move is a single copy.
+ */
+struct Snapshot : BoardState {
+	Move move; // The move that resulted in the current position.
+};
+
+typedef Snapshot HistoryEntry;
+#else
+typedef History HistoryEntry;
+#endif
+
 /**
  * A struct representing the current board position.
  */
-class Position {
+class Position : private BoardState {
 	public:
 		/**
 		 * @brief Initialise the Position object. Uses a FEN string of a normal starting position if none is given.
@@ -30,6 +86,13 @@ class Position {
 		 */
 		void parseFen(const std::string fen);
 
+		/**
+		 * @brief Write the position as a FEN string, the inverse of parseFen.
+		 *
+		 * @return FEN string of the position.
+		 */
+		std::string getFen() const;
+
 		/**
 		 * @brief Zeros out the class variables to make way for parsing a new FEN string.
 		 */
@@ -42,6 +105,70 @@ class Position {
 		 */
 		ExitCode isEOG(MoveList&) const;
 
+		/**
+		 * @brief Check if the game is finished, ignoring repetitions. Used for positions played with playMove.
+		 *
+		 * @return Current game state.
+		 */
+		ExitCode isEOGIgnoringRepetition(MoveList&) const;
+
+		/**
+		 * @brief Check if the game is drawn by repetition, the fifty move rule or insufficient material. Unlike isEOG,
+		 * needs no moves, so does not detect stalemate.
+		 *
+		 * @return True if drawn, else false.
+		 */
+		bool isDrawn() const;
+
+		/**
+		 * @brief Check if a move captures a piece.
+		 *
+		 * @param move Move to check.
+		 * @return True if the move is a capture, including en-passant, else false.
+		 */
+		inline bool isCapture(const Move move) const {
+			return this->pieces[end(move)] != NO_PIECE || type(move) == EN_PASSANT;
+		}
+
+		/**
+		 * @brief Check if a move, such as one from the transposition table, is legal in the position without
+		 * generating the moves. Checks that the piece on the start square belongs to the player to move and can reach
+		 * the end square, and that the move does not leave the king in check.
+		 *
+		 * @param move Move to check. May come from any position.
+		 * @return True if the move is one of the legal moves of the position, else false.
+		 */
+		bool isLegal(const Move move) const;
+
+		/**
+		 * @brief Get the piece on a square.
+		 *
+		 * @param square Square to look at.
+		 * @return Piece on the square, or NO_PIECE if it is empty.
+		 */
+		inline PieceType getPiece(const Square square) const {
+			return this->pieces[square];
+		}
+
+		/**
+		 * @brief Check if a square holds a piece of the player to move.
+		 *
+		 * @param square Square to check.
+		 * @return True if the player to move has a piece on the square, else false.
+		 */
+		inline bool isOwnPiece(const Square square) const {
+			return this->sides[this->turn] & (ONE_BB << square);
+		}
+
+		#ifdef FLAT_MOVE_LIST
+		/**
+		 * @brief Retrives all legal moves of the current position.
+		 *
+		 * @param moveCount Number of moves in the moves array. Moves are added after it.
+		 * @param moves Array that receives the moves.
+		 */
+		void getMoves(uint& moveCount, Move moves[MAX_MOVES]);
+		#else
 		/**
 		 * @brief Retrives all legal moves of the current position.
 		 *
@@ -49,20 +176,52 @@ class Position {
 		 * @param pos_moves Array that holds pointers to vectors of moves.
 		 */
 		void getMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]);
+		#endif
+
+		/**
+		 * @brief Count the legal moves of the current position without retrieving them. Uses the same checks as
+		 * getMoves, but counts the targets of each piece from its reach bitboard instead of looking up its move set.
+		 *
+		 * @return Number of legal moves.
+		 */
+		uint64_t countMoves();
 
 		/**
 		 * @brief Performs the given move on the board position.
 		 *
 		 * @param move The move to perform.
-		 * @param hash Whether or not to hash the positions. Defaulted to true.
 		 */
-		void processMakeMove(const Move move, const bool hash = true);
+		void processMakeMove(const Move move);
 
 		/**
 		 * @brief Undoes the last move made.
 		 */
 		void processUndoMove();
 
+		/**
+		 * @brief Mark the current position as the root of a search.
+		 *
+		 * @param twoFold If true, repeating a position seen after the root is a draw. Otherwise, and for positions
+		 * before the root, a draw needs three occurrences.
+		 */
+		void setSearchRoot(const bool twoFold);
+
+		/**
+		 * @brief Copy only the board state of another position. The history is left empty, so the copy should only be
+		 * played forward with playMove.
+		 *
+		 * @param position Position to copy.
+		 */
+		void copyBoard(const Position& position);
+
+		/**
+		 * @brief Performs the given move without saving history. The move cannot be undone and repetitions cannot be
+		 * detected. Used for rollouts.
+		 *
+		 * @param move The move to perform.
+		 */
+		void playMove(const Move move);
+
 		/**
 		 * @brief Display the board position and information.
 		 */
@@ -92,11 +251,11 @@ class Position {
 		}
 
 		/**
-		 * @brief Get the history vector.
+		 * @brief Get the history stack.
 		 *
-		 * @return Reference to history vector.
+		 * @return Reference to history stack.
 		 */
-		inline const std::vector<History>& getHistory() const {
+		inline const HistoryStack<HistoryEntry>& getHistory() const {
 			return this->history;
 		}
 
@@ -151,38 +310,76 @@ class Position {
 			return this->piece_list[T][index];
 		}
 
-	private:
-		// Non-position information
-		Player turn;
-		uint castling;
-		Square en_passant;
-		uint halfmove, fullmove;
-
-		// Bitboards
-		Bitboard sides[PLAYER_COUNT];
-		Bitboard kings, queens, rooks, bishops, knights, pawns;
-		Bitboard rook_pins;
-		Bitboard bishop_pins;
-		Bitboard check_rays;
-		Bitboard checkers;
-		Bitboard rook_ep_pins;
-
-		// Piece positions
-		uint piece_index[PIECE_TYPE_COUNT];
-		Square piece_list[PIECE_TYPE_COUNT][MAX_PIECE_COUNT];
-		PieceType pieces[SQUARE_COUNT];
-
-		// Piece counts for insufficient material checks.
-		uint piece_cnt;
-		uint knight_cnt;
-		uint bishop_cnt;
-		uint light_bishop_cnt;
-		uint dark_bishop_cnt;
+		/**
+		 * @brief Get the material balance.
+		 *
+		 * @return Material balance in centipawns from white's perspective.
+		 */
+		inline int getMaterial() const {
+			return this->material;
+		}
 
+		/**
+		 * @brief Get the sum of the middlegame piece square values.
+		 *
+		 * @return Middlegame piece square value in centipawns from white's perspective.
+		 */
+		inline int getMiddlegamePsqt() const {
+			return this->psqt_middlegame;
+		}
+
+		/**
+		 * @brief Get the sum of the endgame piece square values.
+		 *
+		 * @return Endgame piece square value in centipawns from white's perspective.
+		 */
+		inline int getEndgamePsqt() const {
+			return this->psqt_endgame;
+		}
+
+		/**
+		 * @brief Get the game phase, the sum of the phase weights of the pieces on the board.
+		 *
+		 * @return Game phase. Can exceed PSQT::MAX_PHASE after promotions.
+		 */
+		inline int getPhase() const {
+			return this->phase;
+		}
+
+		/**
+		 * @brief Get the first layer of the network for the position. Only maintained while a network is loaded.
+		 *
+		 * @return Reference to the accumulator.
+		 */
+		inline const NnueAccumulator& getAccumulator() const {
+			return this->accumulator;
+		}
+
+		/**
+		 * @brief Recompute the accumulator from the pieces on the board. Must be called after loading a network.
+		 */
+		void refreshAccumulator();
+
+		/**
+		 * @brief Check if king of current player to move is in check. Only valid once the moves of the position have
+		 * been generated.
+		 *
+		 * @return: True if in check, else false.
+		 */
+		inline bool inCheck() const {
+			return this->checkers;
+		}
+
+	private:
 		// Position history
-		std::vector<History> history;
-		std::unordered_map<Bitboard, int> positionCounts;
-		Hash hash;
+		HistoryStack<HistoryEntry> history;
+
+		// Repetition rules of the current search. See setSearchRoot.
+		size_t searchRoot = 0;
+		bool twoFoldRepetition = false;
+
+		// Kept outside of BoardState so that copy-make history and rollout copies do not carry it.
+		NnueAccumulator accumulator;
 
 		/**
 		 * @brief Get the piece type based on the base piece type.
@@ -194,6 +391,31 @@ class Position {
 		template<BasePieceType T>
 		inline PieceType getPieceType(const bool enemy = false) const;
 
+		/**
+		 * @brief Add the material and piece square values of a piece to the evaluation terms.
+		 *
+		 * @param piece Piece type.
+		 * @param square Square of the piece.
+		 */
+		void addEvaluation(const PieceType piece, const Square square);
+
+		/**
+		 * @brief Remove the material and piece square values of a piece from the evaluation terms.
+		 *
+		 * @param piece Piece type.
+		 * @param square Square of the piece.
+		 */
+		void removeEvaluation(const PieceType piece, const Square square);
+
+		/**
+		 * @brief Move the piece square values of a piece in the evaluation terms.
+		 *
+		 * @param piece Piece type.
+		 * @param start Square the piece leaves.
+		 * @param end Square the piece arrives on.
+		 */
+		void moveEvaluation(const PieceType piece, const Square start, const Square end);
+
 		/**
 		 * @brief Moves the piece from start to end square. Updates the piece_list and pieces array.
 		 *
@@ -341,140 +563,153 @@ class Position {
 		 */
 		bool inDoubleCheck() const;
 
+
 		/**
-		 * @brief Check if king of current player to move is in check.
+		 * @brief Pass the move sets of the current position to the sink.
 		 *
-		 * @return: True if in check, else false.
+		 * @param sink Receives the move sets. Its add(count, lookup) is called for every move set with the number of
+		 * moves in the set and a function that looks the set up.
 		 */
-		bool inCheck() const;
+		template<typename Sink>
+		void generateMoves(Sink& sink);
 
 		/**
-		 * @brief Add the vector of king moves to the pos_moves array.
+		 * @brief Get the number of moves of a pawn to the squares of a reach bitboard. Each promotion square is four
+		 * moves.
 		 *
-		 * @param moves_index Index of the first empty position in the pos_moves array.
-		 * @param pos_moves Array that holds pointers to vectors of moves.
+		 * @param reach Squares the pawn can move to.
+		 * @param square Square of the pawn.
+		 * @return Number of moves.
 		 */
-		void getKingMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const;
+		uint getPawnMoveCount(const Bitboard reach, const Square square) const;
 
 		/**
-		 * @brief Add vectors of moves to the pos_moves array for when the king is in check.
+		 * @brief Add the vector of king moves to the sink.
 		 *
-		 * @param moves_index Index of the first empty position in the pos_moves array.
-		 * @param pos_moves Array that holds pointers to vectors of moves.
+		 * @param sink Receives the move sets.
 		 */
-		void getCheckMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const;
+		template<typename Sink>
+		void getKingMoves(Sink& sink) const;
 
 		/**
-		 * @brief Add vectors of queen moves to the pos_moves array for when the king is in check.
+		 * @brief Add vectors of moves to the sink for when the king is in check.
 		 *
-		 * @param moves_index Index of the first empty position in the pos_moves array.
-		 * @param pos_moves Array that holds pointers to vectors of moves.
+		 * @param sink Receives the move sets.
 		 */
-		void getQueenCheckedMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const;
+		template<typename Sink>
+		void getCheckMoves(Sink& sink) const;
 
 		/**
-		 * @brief Add vectors of rook moves to the pos_moves array for when the king is in check.
+		 * @brief Add vectors of queen moves to the sink for when the king is in check.
 		 *
-		 * @param moves_index Index of the first empty position in the pos_moves array.
-		 * @param pos_moves Array that holds pointers to vectors of moves.
+		 * @param sink Receives the move sets.
 		 */
-		void getRookCheckedMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const;
+		template<typename Sink>
+		void getQueenCheckedMoves(Sink& sink) const;
 
 		/**
-		 * @brief Add vectors of bishop moves to the pos_moves array for when the king is in check.
+		 * @brief Add vectors of rook moves to the sink for when the king is in check.
 		 *
-		 * @param moves_index Index of the first empty position in the pos_moves array.
-		 * @param pos_moves Array that holds pointers to vectors of moves.
+		 * @param sink Receives the move sets.
 		 */
-		void getBishopCheckedMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const;
+		template<typename Sink>
+		void getRookCheckedMoves(Sink& sink) const;
 
 		/**
-		 * @brief Add vectors of knight moves to the pos_moves array for when the king is in check.
+		 * @brief Add vectors of bishop moves to the sink for when the king is in check.
 		 *
-		 * @param moves_index Index of the first empty position in the pos_moves array.
-		 * @param pos_moves Array that holds pointers to vectors of moves.
+		 * @param sink Receives the move sets.
 		 */
-		void getKnightCheckedMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const;
+		template<typename Sink>
+		void getBishopCheckedMoves(Sink& sink) const;
 
 		/**
-		 * @brief Add vectors of pawn moves to the pos_moves array for when the king is in check.
+		 * @brief Add vectors of knight moves to the sink for when the king is in check.
 		 *
-		 * @param moves_index Index of the first empty position in the pos_moves array.
-		 * @param pos_moves Array that holds pointers to vectors of moves.
+		 * @param sink Receives the move sets.
 		 */
-		void getPawnCheckedMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const;
+		template<typename Sink>
+		void getKnightCheckedMoves(Sink& sink) const;
 
 		/**
-		 * @brief Add vectors of en-passant moves to the pos_moves array for when the king is in check.
+		 * @brief Add vectors of pawn moves to the sink for when the king is in check.
 		 *
-		 * @param moves_index Index of the first empty position in the pos_moves array.
-		 * @param pos_moves Array that holds pointers to vectors of moves.
+		 * @param sink Receives the move sets.
 		 */
-		void getEnPassantCheckMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const;
+		template<typename Sink>
+		void getPawnCheckedMoves(Sink& sink) const;
 
 		/**
-		 * @brief Add vectors of moves to the pos_moves array for when there is no check.
+		 * @brief Add vectors of en-passant moves to the sink for when the king is in check.
 		 *
-		 * @param moves_index Index of the first empty position in the pos_moves array.
-		 * @param pos_moves Array that holds pointers to vectors of moves.
+		 * @param sink Receives the move sets.
 		 */
-		void getNormalMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const;
+		template<typename Sink>
+		void getEnPassantCheckMoves(Sink& sink) const;
 
 		/**
-		 * @brief Add vectors of queen moves to the pos_moves array for when there is no check.
+		 * @brief Add vectors of moves to the sink for when there is no check.
 		 *
-		 * @param moves_index Index of the first empty position in the pos_moves array.
-		 * @param pos_moves Array that holds pointers to vectors of moves.
+		 * @param sink Receives the move sets.
 		 */
-		void getQueenMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const;
+		template<typename Sink>
+		void getNormalMoves(Sink& sink) const;
 
 		/**
-		 * @brief Add vectors of rook moves to the pos_moves array for when there is no check.
+		 * @brief Add vectors of queen moves to the sink for when there is no check.
 		 *
-		 * @param moves_index Index of the first empty position in the pos_moves array.
-		 * @param pos_moves Array that holds pointers to vectors of moves.
+		 * @param sink Receives the move sets.
 		 */
-		void getRookMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const;
+		template<typename Sink>
+		void getQueenMoves(Sink& sink) const;
 
 		/**
-		 * @brief Add vectors of bishop moves to the pos_moves array for when there is no check.
+		 * @brief Add vectors of rook moves to the sink for when there is no check.
 		 *
-		 * @param moves_index Index of the first empty position in the pos_moves array.
-		 * @param pos_moves Array that holds pointers to vectors of moves.
+		 * @param sink Receives the move sets.
 		 */
-		void getBishopMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const;
+		template<typename Sink>
+		void getRookMoves(Sink& sink) const;
 
 		/**
-		 * @brief Add vectors of knight moves to the pos_moves array for when there is no check.
+		 * @brief Add vectors of bishop moves to the sink for when there is no check.
 		 *
-		 * @param moves_index Index of the first empty position in the pos_moves array.
-		 * @param pos_moves Array that holds pointers to vectors of moves.
+		 * @param sink Receives the move sets.
 		 */
-		void getKnightMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const;
+		template<typename Sink>
+		void getBishopMoves(Sink& sink) const;
 
 		/**
-		 * @brief Add vectors of castling moves to the pos_moves array.
+		 * @brief Add vectors of knight moves to the sink for when there is no check.
 		 *
-		 * @param moves_index Index of the first empty position in the pos_moves array.
-		 * @param pos_moves Array that holds pointers to vectors of moves.
+		 * @param sink Receives the move sets.
 		 */
-		void getCastlingMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const;
+		template<typename Sink>
+		void getKnightMoves(Sink& sink) const;
 
 		/**
-		 * @brief Add vectors of en-passant moves to the pos_moves array for when there is no check.
+		 * @brief Add vectors of castling moves to the sink.
 		 *
-		 * @param moves_index Index of the first empty position in the pos_moves array.
-		 * @param pos_moves Array that holds pointers to vectors of moves.
+		 * @param sink Receives the move sets.
 		 */
-		void getEnPassantMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const;
+		template<typename Sink>
+		void getCastlingMoves(Sink& sink) const;
 
 		/**
-		 * @brief Add vectors of pawn moves to the pos_moves array for when there is no check.
+		 * @brief Add vectors of en-passant moves to the sink for when there is no check.
 		 *
-		 * @param moves_index Index of the first empty position in the pos_moves array.
-		 * @param pos_moves Array that holds pointers to vectors of moves.
+		 * @param sink Receives the move sets.
 		 */
-		void getPawnMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE]) const;
+		template<typename Sink>
+		void getEnPassantMoves(Sink& sink) const;
+
+		/**
+		 * @brief Add vectors of pawn moves to the sink for when there is no check.
+		 *
+		 * @param sink Receives the move sets.
+		 */
+		template<typename Sink>
+		void getPawnMoves(Sink& sink) const;
 
 		/**
 		 * @brief Get the reach bitboard of a rook on the specified square.
@@ -495,24 +730,24 @@ class Position {
 		Bitboard getBishopReachBB(const Bitboard occupancy, const Square square) const;
 
 		/**
-		 * @brief Add vector of moves to the pos_moves array for a diagonally pinned queen/bishop on the specified
+		 * @brief Add vector of moves to the sink for a diagonally pinned queen/bishop on the specified
 		 * square.
 		 *
-		 * @param moves_index Index of the first empty position in the pos_moves array.
-		 * @param pos_moves Array that holds pointers to vectors of moves.
+		 * @param sink Receives the move sets.
 		 * @param square Square of the piece.
 		 */
-		void getBishopPinMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE], const Square square) const;
+		template<typename Sink>
+		void getBishopPinMoves(Sink& sink, const Square square) const;
 
 		/**
-		 * @brief Add vector of moves to the pos_moves array for a horizontally or vertically pinned queen/bishop on the
+		 * @brief Add vector of moves to the sink for a horizontally or vertically pinned queen/bishop on the
 		 * specified square.
 		 *
-		 * @param moves_index Index of the first empty position in the pos_moves array.
-		 * @param pos_moves Array that holds pointers to vectors of moves.
+		 * @param sink Receives the move sets.
 		 * @param square Square of the piece.
 		 */
-		void getRookPinMoves(uint& moves_index, MoveSet pos_moves[MOVESET_SIZE], const Square square) const;
+		template<typename Sink>
+		void getRookPinMoves(Sink& sink, const Square square) const;
 
 		/**
 		 * @brief Check if the given square is occupied.
@@ -721,21 +956,12 @@ class Position {
 		void updateTurn();
 
 		/**
-		 * @brief Check if the current position is a draw by threefold repetition.
+		 * @brief Check if the current position is a draw by repetition. Scans the hashes in the history for every
+		 * second ply, back to the last irreversible move.
 		 *
-		 * @return True if draw by threefold repetition, else false.
+		 * @return True if draw by repetition, else false.
 		 */
-		bool isThreeFoldRep() const;
-
-		/**
-		 * @brief Increment the current position count.
-		 */
-		void incrementPositionCounter();
-
-		/**
-		 * @brief Decrement the current position count.
-		 */
-		void decrementPositionCounter(Hash);
+		bool isRepetition() const;
 };
 
 class MoveList {
@@ -752,6 +978,19 @@ class MoveList {
 		 */
 		uint64_t size() const;
 
+		/**
+		 * @brief Check if the movelist has no moves.
+		 *
+		 * @return True if there are no moves, else false.
+		 */
+		inline bool empty() const {
+			#ifdef FLAT_MOVE_LIST
+			return this->moveCount == 0;
+			#else
+			return this->moves_index == 0; // Move sets are never empty.
+			#endif
+		}
+
 		/**
 		 * @brief Check if the movelist contains the specified move.
 		 *
@@ -761,14 +1000,27 @@ class MoveList {
 		bool contains(const Move move) const;
 
 		/**
-		 * @brief Get a random move.
+		 * @brief Get a random move. Every move is equally likely.
 		 *
 		 * @return A random move from the movelist.
 		 */
 		Move randomMove() const;
 
+		#ifdef FLAT_MOVE_LIST
+		inline const Move* begin() const {
+			return this->moves;
+		}
+
+		inline const Move* end() const {
+			return this->moves + this->moveCount;
+		}
+
+	private:
+		uint moveCount = 0;
+		Move moves[MAX_MOVES];
+		#else
 		struct Iterator {
-			Iterator(int vecCnt, int i, int j, MoveSet* pos_moves, const Move* endMove);
+			Iterator(int vecCnt, int i, MoveSet* pos_moves, const Move* endMove);
 
 			const Move& operator*() const;
 			const Move* operator->() const;
@@ -786,8 +1038,9 @@ class MoveList {
 
 			private:
 				const Move* ptr;
+				const Move* setEnd; // One past the last move of the current move set.
 				MoveSet* moves;
-				int vecCnt, i, j;
+				int vecCnt, i;
 				const Move* endAddr;
 		};
 
@@ -797,6 +1050,7 @@ class MoveList {
 		uint moves_index = 0;
 		MoveSet moveSets[MOVESET_SIZE];
 		const Move* endMove = nullptr; // Dummy move for end of iterator. Just need the address.
+		#endif
 };
 
 /**
@@ -807,33 +1061,4 @@ class MoveList {
  */
 std::string concatFEN(const std::vector<std::string> strings);
 
-/**
- * @brief Generate zobrist piece hashes using a predefined seed.
- *
- * @return Array of size 12 (each piece for each colour) containing arrays of size SQUARE_COUNT Hashes.
- */
-std::array<std::array<Hash, SQUARE_COUNT>, PIECE_TYPE_COUNT> generatePieceHashes();
-
-/**
- * @brief Generate zobrist hashes for the turn using predefined seed.
- *
- * @return Hash representing turn.
- */
-Hash generateTurnHash();
-
-/**
- * @brief Generate zobrist hashes for different castling permissions combinations using a predefined seed.
- *
- * @return Array of size 16 (the number of possible castling permission combinations) of Hashes.
- */
-std::array<Hash, CASTLING_COMBOS> generateCastlingHash();
-
-/**
- * @brief Generate zobrist hashes for en passant file using predefined seed. The colour of the player who can capture
- * en-passant is taken care of by the turn hash.
- *
- * @return Array of size 8 (number of files) of Hashes.
- */
-std::array<Hash, FILE_COUNT> generateEnPassantHash();
-
 #endif
\ No newline at end of file
@@ -0,0 +1,94 @@
+#ifndef HISTORY_HPP
+#define HISTORY_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+
+#include "constants.hpp"
+
+/**
+ * A fixed capacity stack of history entries, stored as a ring buffer. Storage is allocated once, so pushing never
+ * reallocates. Once more than HISTORY_CAPACITY entries have been pushed, the oldest entries are overwritten and can no
+ * longer be popped. Copying only copies the live entries.
+ *
+ * @tparam T Type of the history entry.
+ */
+template<typename T>
+class HistoryStack {
+	public:
+		HistoryStack() : entries(std::make_unique_for_overwrite<T[]>(HISTORY_CAPACITY)) {}
+
+		HistoryStack(const HistoryStack& other) : HistoryStack() {
+			*this = other;
+		}
+
+		HistoryStack& operator=(const HistoryStack& other) {
+			if (this == &other) return *this;
+			this->top = other.top;
+			this->count = other.count;
+			for (size_t index = 1; index <= this->count; index++)
+				this->entries[(this->top - index) & HISTORY_MASK] = other.entries[(other.top - index) & HISTORY_MASK];
+			return *this;
+		}
+
+		inline void push(const T& entry) {
+			this->entries[this->top & HISTORY_MASK] = entry;
+			this->top++;
+			this->count = std::min(this->count + 1, static_cast<size_t>(HISTORY_CAPACITY));
+		}
+
+		inline void pop() {
+			assert(this->count > 0);
+			this->top--;
+			this->count--;
+		}
+
+		inline T& back() const {
+			assert(this->count > 0);
+			return this->entries[(this->top - 1) & HISTORY_MASK];
+		}
+
+		/**
+		 * @brief Get an entry counting back from the most recent.
+		 *
+		 * @param ago Number of entries back. 0 is the most recent entry. Must be less than size().
+		 * @return Reference to the entry.
+		 */
+		inline const T& fromBack(const size_t ago) const {
+			assert(ago < this->count);
+			return this->entries[(this->top - 1 - ago) & HISTORY_MASK];
+		}
+
+		inline size_t size() const {
+			return this->count;
+		}
+
+		/**
+		 * @brief Get the number of entries pushed and not popped since the last clear, including overwritten ones.
+		 *
+		 * @return Height of the stack.
+		 */
+		inline size_t height() const {
+			return this->top;
+		}
+
+		inline bool empty() const {
+			return this->count == 0;
+		}
+
+		inline void clear() {
+			this->top = 0;
+			this->count = 0;
+		}
+
+	private:
+		static constexpr size_t HISTORY_MASK = HISTORY_CAPACITY - 1;
+		static_assert((HISTORY_CAPACITY & HISTORY_MASK) == 0, "HISTORY_CAPACITY must be a power of two");
+
+		std::unique_ptr<T[]> entries;
+		size_t top = 0;   // Total number of entries pushed and not popped. The next entry goes at top % capacity.
+		size_t count = 0; // Number of entries that can still be popped.
+};
+
+#endif
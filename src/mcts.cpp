@@ -1,111 +1,403 @@
 #include <memory>
+#include <algorithm>
+#include <new>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #include "sicario.hpp"
 #include "mcts.hpp"
 #include "uci.hpp"
+#include "transposition.hpp"
+#include "evaluate.hpp"
+#include "threadpool.hpp"
 
-// NOTE Due to way that the tree is constructed, it may result in stack overflow error due to node deletion/pruning.
+MctsNodeArena MctsArena;
+Hash Mcts::treeRootHash = 0;
 
-const float C = std::sqrt(2);
+uint ucb1Argmax(const float* values, const uint* visits, const uint* virtualLoss, const uint count,
+		const float logParentVisits) {
+	uint best = 0;
+	float bestValue = -std::numeric_limits<float>::infinity();
+	uint index = 0;
+
+	#if defined(__AVX2__)
+	const __m256 c = _mm256_set1_ps(C);
+	const __m256 logParent = _mm256_set1_ps(logParentVisits);
+	const __m256 unvisitedValue = _mm256_set1_ps(std::numeric_limits<float>::max());
+	const __m256i step = _mm256_set1_epi32(8);
+	__m256 bestValues = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+	__m256i bestIndices = _mm256_setzero_si256();
+	__m256i indices = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	for (; index + 8 <= count; index += 8) {
+		__m256i loss = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(virtualLoss + index));
+		__m256i n = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(visits + index)), loss);
+		__m256 nf = _mm256_cvtepi32_ps(n);
+		__m256 q = _mm256_div_ps(_mm256_sub_ps(_mm256_loadu_ps(values + index), _mm256_cvtepi32_ps(loss)), nf);
+		__m256 score = _mm256_add_ps(q, _mm256_mul_ps(c, _mm256_sqrt_ps(_mm256_div_ps(logParent, nf))));
+		__m256 unvisited = _mm256_castsi256_ps(_mm256_cmpeq_epi32(n, _mm256_setzero_si256()));
+		score = _mm256_blendv_ps(score, unvisitedValue, unvisited);
+
+		__m256 better = _mm256_cmp_ps(score, bestValues, _CMP_GT_OQ);
+		bestValues = _mm256_blendv_ps(bestValues, score, better);
+		bestIndices = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(bestIndices),
+				_mm256_castsi256_ps(indices), better));
+		indices = _mm256_add_epi32(indices, step);
+	}
+
+	const uint LANES = 8;
+	alignas(32) float laneValues[LANES];
+	alignas(32) uint laneIndices[LANES];
+	_mm256_store_ps(laneValues, bestValues);
+	_mm256_store_si256(reinterpret_cast<__m256i*>(laneIndices), bestIndices);
+	#elif defined(__SSE2__)
+	const __m128 c = _mm_set1_ps(C);
+	const __m128 logParent = _mm_set1_ps(logParentVisits);
+	const __m128 unvisitedValue = _mm_set1_ps(std::numeric_limits<float>::max());
+	const __m128i step = _mm_set1_epi32(4);
+	__m128 bestValues = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+	__m128i bestIndices = _mm_setzero_si128();
+	__m128i indices = _mm_setr_epi32(0, 1, 2, 3);
+	for (; index + 4 <= count; index += 4) {
+		__m128i loss = _mm_loadu_si128(reinterpret_cast<const __m128i*>(virtualLoss + index));
+		__m128i n = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(visits + index)), loss);
+		__m128 nf = _mm_cvtepi32_ps(n);
+		__m128 q = _mm_div_ps(_mm_sub_ps(_mm_loadu_ps(values + index), _mm_cvtepi32_ps(loss)), nf);
+		__m128 score = _mm_add_ps(q, _mm_mul_ps(c, _mm_sqrt_ps(_mm_div_ps(logParent, nf))));
+		__m128 unvisited = _mm_castsi128_ps(_mm_cmpeq_epi32(n, _mm_setzero_si128()));
+		score = _mm_or_ps(_mm_and_ps(unvisited, unvisitedValue), _mm_andnot_ps(unvisited, score));
+
+		__m128 better = _mm_cmpgt_ps(score, bestValues);
+		bestValues = _mm_or_ps(_mm_and_ps(better, score), _mm_andnot_ps(better, bestValues));
+		__m128i betterIndices = _mm_castps_si128(better);
+		bestIndices = _mm_or_si128(_mm_and_si128(betterIndices, indices), _mm_andnot_si128(betterIndices, bestIndices));
+		indices = _mm_add_epi32(indices, step);
+	}
+
+	const uint LANES = 4;
+	alignas(16) float laneValues[LANES];
+	alignas(16) uint laneIndices[LANES];
+	_mm_store_ps(laneValues, bestValues);
+	_mm_store_si128(reinterpret_cast<__m128i*>(laneIndices), bestIndices);
+	#endif
+
+	#if defined(__AVX2__) || defined(__SSE2__)
+	// Each lane holds the first best of its own children, so ties across lanes go to the lowest index.
+	for (uint lane = 0; lane < LANES; lane++) {
+		if (laneValues[lane] > bestValue || (laneValues[lane] == bestValue && laneIndices[lane] < best)) {
+			bestValue = laneValues[lane];
+			best = laneIndices[lane];
+		}
+	}
+	#endif
+
+	// Scalar fallback, and the remainder that does not fill a vector.
+	for (; index < count; index++) {
+		float score = ucb1FromLog(values[index] - virtualLoss[index], visits[index] + virtualLoss[index],
+				logParentVisits);
+		if (score > bestValue) {
+			bestValue = score;
+			best = index;
+		}
+	}
+	return best;
+}
 
 void Mcts::search() {
+	const uint threadCount = Threads.size();
+	const bool rootParallel = this->sicarioConfigs.options[MCTS_PARALLEL].value == "root";
+
+	// Tree parallel workers share a single tree, which carries on from the tree of the previous search if it reached
+	// this position. Root parallel workers each grow their own tree from the root. Otherwise, the previous search's
+	// tree is released in one go.
+	this->roots.clear();
+	MctsNode* reusedRoot = rootParallel ? nullptr : reuseTree();
+	if (reusedRoot != nullptr) {
+		this->roots.push_back(reusedRoot);
+	} else {
+		MctsArena.clear();
+		const uint rootCount = rootParallel ? threadCount : 1;
+		const NodeIndex firstRoot = MctsArena.allocate(rootCount);
+		for (uint id = 0; id < rootCount; id++)
+			this->roots.push_back(new (&MctsArena[firstRoot + id]) MctsNode(NULL_NODE, NULL_MOVE, 0));
+	}
+	treeRootHash = this->getPos().getHash();
+
+	this->playouts = 0;
+	this->stopped = false;
+	// Each helper plays out in the position of its own search state. The positions are copied before any worker starts,
+	// as the first worker plays out in the root position itself.
+	for (uint id = 1; id < threadCount; id++) {
+		MctsNode* root = this->roots[rootParallel ? id : 0];
+		Position& pos = Threads[id].getState().pos;
+		pos = this->pos;
+		Threads[id].run([this, root, &pos, id]() { this->work(root, pos, id); });
+	}
+	work(this->roots[0], this->pos, 0);
+	for (uint id = 1; id < threadCount; id++) Threads[id].wait();
+
+	this->roots[0]->storePrincipalVariation(this->getPos());
+}
+
+void Mcts::sendBestMove() {
+	Uci::sendBestMove(this->roots, sicarioConfigs.debugMode, sicarioConfigs.options[PONDER].value == "true");
+}
+
+MctsNode* Mcts::reuseTree() {
+	if (MctsArena.empty()) return nullptr;
+
+	// The history holds the hash of the position before each move, so the root of the old tree is found by walking
+	// back, and then the moves since are replayed down the tree.
+	const Position& pos = this->getPos();
+	const HistoryStack<HistoryEntry>& history = pos.getHistory();
+	for (size_t plies = 0; plies <= std::min(MAX_REUSE_PLIES, history.size()); plies++) {
+		const Hash hash = plies == 0 ? pos.getHash() : history.fromBack(plies - 1).hash;
+		if (hash != treeRootHash) continue;
+
+		MctsNode* node = &MctsArena[0];
+		for (size_t ago = plies; ago > 0 && node != nullptr; ago--)
+			node = node->findChild(history.fromBack(ago - 1).move);
+		return node != nullptr ? node->makeRoot() : nullptr;
+	}
+	return nullptr;
+}
+
+void Mcts::work(MctsNode* root, Position& pos, const uint id) {
+	Rollout rollout(std::stoi(this->sicarioConfigs.options[ROLLOUT_PLIES].value));
 	SearchInfo searchInfo;
-	std::unique_ptr<MctsNode> root(new MctsNode(nullptr, NULL_MOVE, this->getPos(), searchInfo));
-	while (searchTree) {
+	const int depthLimit = this->timeManager.getDepthLimit();
+	while (searchTree && !this->stopped.load(std::memory_order_relaxed)) {
 		SearchInfo oldSearchInfo = searchInfo; // TODO implement smarter way of checking if something has changed
 
-		MctsNode* leaf = root->select();
-		leaf = leaf->expand();
-		float val = leaf->simulate();
-		leaf->rollback(val);
+		MctsNode* leaf = root->select(pos);
+		leaf = leaf->expand(pos);
+		searchInfo.depth = std::max(searchInfo.depth, leaf->getDepth());
+		if (id == 0) searchInfo.hashfull = MctsArena.hashfull();
+		float val = rollout.play(pos);
+		leaf->rollback(val, pos);
+		const uint64_t playouts = this->playouts.fetch_add(1, std::memory_order_relaxed) + 1;
 
-		if (searchInfo != oldSearchInfo) Uci::sendInfo(searchInfo);
+		if (id == 0 && this->report && searchInfo != oldSearchInfo) Uci::sendInfo(searchInfo);
+
+		// Playouts are short, so every worker checks the limits after each one and stops the others once one is met.
+		if (this->timeManager.softLimitReached() || this->timeManager.nodeLimitReached(playouts) ||
+				(depthLimit > 0 && searchInfo.depth >= depthLimit))
+			this->stopped = true;
 	}
-	Uci::sendBestMove(root.get(), sicarioConfigs.debugMode);
 }
 
-MctsNode::MctsNode(MctsNode* parent, Move move, Position& pos, SearchInfo& searchInfo) :
-		BaseNode(parent, pos, searchInfo) {
-	this->inEdge = move; // CHECK initialise here? or in initialiser list?
-	this->depth = parent == nullptr ? 0 : parent->depth + 1;
-	this->searchInfo.depth = std::max(this->searchInfo.depth, this->depth);
+MctsNode::MctsNode(NodeIndex parent, Move move, int depth) : BaseNode(parent, move, depth) {
+	this->stat<VALUE_COLUMN>() = 0;
+	this->stat<VISITS_COLUMN>() = 0;
+	this->stat<VIRTUAL_LOSS_COLUMN>() = 0;
+}
+
+MctsNode& MctsNode::operator=(const MctsNode& node) {
+	BaseNode::operator=(node);
+	this->state.store(node.state.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	return *this;
 }
 
 MctsNode* MctsNode::bestChild() {
-	return dynamic_cast<MctsNode*>((*std::max_element(children.begin(), children.end(), MctsNode::Ucb1Comp())).get());
+	// Nodes currently being searched by other threads look like they have lost their in-flight playouts. The log term
+	// is shared by all children so is only computed once.
+	const uint virtualLoss = std::atomic_ref(this->stat<VIRTUAL_LOSS_COLUMN>()).load(std::memory_order_relaxed);
+	const float logParentVisits = std::log(static_cast<float>(this->getVisits() + virtualLoss));
+
+	// Other workers update the statistics of the children while they are read, so they are copied out with atomic loads
+	// first and the vector kernel runs on the copy. The copy may mix values from before and after an update, which only
+	// perturbs the choice of child. The buffers are kept per thread rather than on the stack of every call.
+	alignas(32) static thread_local float values[MAX_MOVES];
+	alignas(32) static thread_local uint visits[MAX_MOVES];
+	alignas(32) static thread_local uint virtualLosses[MAX_MOVES];
+	float* valueColumn = MctsArena.column<VALUE_COLUMN>() + this->firstChild;
+	uint* visitsColumn = MctsArena.column<VISITS_COLUMN>() + this->firstChild;
+	uint* virtualLossColumn = MctsArena.column<VIRTUAL_LOSS_COLUMN>() + this->firstChild;
+	for (uint index = 0; index < this->childCount; index++) {
+		values[index] = std::atomic_ref(valueColumn[index]).load(std::memory_order_relaxed);
+		visits[index] = std::atomic_ref(visitsColumn[index]).load(std::memory_order_relaxed);
+		virtualLosses[index] = std::atomic_ref(virtualLossColumn[index]).load(std::memory_order_relaxed);
+	}
+	const uint offset = ucb1Argmax(values, visits, virtualLosses, this->childCount, logParentVisits);
+	return &this->children()[offset];
 }
 
-MctsNode* MctsNode::select() {
-	if (this->children.size() == 0) return this;
-	// NOTE this currently just chooses the last one it comes across if there are multiple of equal value
-	MctsNode* bestChild = this->bestChild();
-	this->getPos().processMakeMove(bestChild->getInEdge());
-	return bestChild->select();
+MctsNode* MctsNode::select(Position& pos) {
+	// NOTE this currently just chooses the first one it comes across if there are multiple of equal value
+	MctsNode* curr = this;
+	while (curr->state.load(std::memory_order_acquire) == EXPANDED) {
+		curr = curr->bestChild();
+		std::atomic_ref(curr->stat<VIRTUAL_LOSS_COLUMN>()).fetch_add(VIRTUAL_LOSS, std::memory_order_relaxed);
+		pos.processMakeMove(curr->getInEdge());
+	}
+	return curr;
 }
 
-MctsNode* MctsNode::expand() {
-	MoveList moves = MoveList(this->getPos());
-	if (visits == 0 || this->getPos().isEOG(moves)) return this;
+MctsNode* MctsNode::expand(Position& pos) {
+	// Unvisited leaves are simulated from rather than expanded, so their moves are not generated.
+	if (this->getVisits() == 0) return this;
+	MoveList moves = MoveList(pos);
+	if (pos.isEOG(moves)) return this;
 
+	// Another thread is already expanding (or has expanded) this node.
+	ExpansionState expected = UNEXPANDED;
+	if (!this->state.compare_exchange_strong(expected, EXPANDING, std::memory_order_acq_rel)) return this;
+
+	Move childMoves[MAX_MOVES];
+	uint count = 0;
 	for (Move move : moves)
-		this->addChild(move);
+		childMoves[count++] = move;
+
+	// Expand the move of a previous search first, if there is one.
+	TTData ttData;
+	if (TT.probe(pos.getHash(), ttData) && ttData.move != NULL_MOVE) {
+		Move* hashMove = std::find(childMoves, childMoves + count, ttData.move);
+		if (hashMove != childMoves + count) std::iter_swap(childMoves, hashMove);
+	}
+
+	// The tree can no longer grow, so keep simulating from this node.
+	if (!this->addChildren(childMoves, count)) {
+		this->state.store(UNEXPANDED, std::memory_order_release);
+		return this;
+	}
 
 	// TODO check if expansion expands into EOG game condition. Need to determine how to handle if this is the case.
 
-	this->getPos().processMakeMove(this->children[0]->getInEdge());
-	return dynamic_cast<MctsNode*>(this->children[0].get()); // NOTE currently just getting the first child.
+	this->state.store(EXPANDED, std::memory_order_release);
+
+	MctsNode* child = &this->children()[0]; // NOTE currently just getting the first child.
+	std::atomic_ref(child->stat<VIRTUAL_LOSS_COLUMN>()).fetch_add(VIRTUAL_LOSS, std::memory_order_relaxed);
+	pos.processMakeMove(child->getInEdge());
+	return child;
 }
 
-float MctsNode::simulate() {
-	MoveList moves = MoveList(this->pos);
-	int moveCount = 0;
+float Rollout::play(const Position& pos) {
+	this->position.copyBoard(pos);
+	const Player player = pos.getTurn();
+	MoveList moves = MoveList(this->position);
+	uint ply = 0;
 	ExitCode code;
-	while (!(code = this->pos.isEOG(moves))) {
-		this->pos.processMakeMove(moves.randomMove());
-		moves = MoveList(this->pos);
-		moveCount++;
-	}
+	while (!(code = this->position.isEOGIgnoringRepetition(moves))) {
+		// Score the cut off game by squashing the evaluation (from white's perspective) into a result.
+		if (this->plyCap != 0 && ply == this->plyCap) {
+			float result = std::tanh(Evaluator::evaluate(this->position, moves) / ROLLOUT_EVAL_SCALE);
+			return player == WHITE ? result : -result;
+		}
 
-	while (moveCount > 0) {
-		this->pos.processUndoMove();
-		moveCount--;
+		this->position.playMove(moves.randomMove());
+		moves = MoveList(this->position);
+		ply++;
 	}
 
 	if (code == WHITE_WINS) {
-		return this->rootPlayer == WHITE ? 1 : -1;
+		return player == WHITE ? 1 : -1;
 	} else if (code == BLACK_WINS) {
-		return this->rootPlayer == BLACK ? 1 : -1;
+		return player == BLACK ? 1 : -1;
 	}
 	return 0;
 }
 
-void MctsNode::rollback(float val) {
+void MctsNode::rollback(float val, Position& pos) {
+	// Each node's value is from the perspective of the player that moved into it, which is the opponent of the player
+	// to move in its position.
 	MctsNode* curr = this;
-	while (curr->parent != nullptr) {
-		curr->visits++;
-		curr->value += this->pos.getTurn() == this->rootPlayer ? -1 * val : val;
-		curr = dynamic_cast<MctsNode*>(curr->parent);
-		this->pos.processUndoMove();
+	while (MctsNode* parent = curr->getParent()) {
+		std::atomic_ref(curr->stat<VALUE_COLUMN>()).fetch_sub(val, std::memory_order_relaxed);
+		std::atomic_ref(curr->stat<VISITS_COLUMN>()).fetch_add(1, std::memory_order_relaxed);
+		std::atomic_ref(curr->stat<VIRTUAL_LOSS_COLUMN>()).fetch_sub(VIRTUAL_LOSS, std::memory_order_relaxed);
+		curr = parent;
+		pos.processUndoMove();
+		val = -val;
+	}
+
+	std::atomic_ref(curr->stat<VALUE_COLUMN>()).fetch_sub(val, std::memory_order_relaxed);
+	std::atomic_ref(curr->stat<VISITS_COLUMN>()).fetch_add(1, std::memory_order_relaxed);
+}
+
+std::span<MctsNode> MctsNode::getChildren() const {
+	if (this->state.load(std::memory_order_acquire) != EXPANDED) return {};
+	return this->children();
+}
+
+MctsNode* MctsNode::mostVisitedChild() const {
+	MctsNode* best = nullptr;
+	for (MctsNode& child : this->getChildren()) {
+		if (best == nullptr || child.getVisits() > best->getVisits()) best = &child;
 	}
+	return best;
+}
 
-	curr->value += this->pos.getTurn() == this->rootPlayer ? -1 * val : val;
-	curr->visits++;
+MctsNode* MctsNode::findChild(const Move move) const {
+	for (MctsNode& child : this->getChildren()) {
+		if (child.getInEdge() == move) return &child;
+	}
+	return nullptr;
 }
 
-const std::vector<MctsNode*> MctsNode::getChildren() const {
-	std::vector<MctsNode*> children;
-	for (auto& child : this->children)
-		children.push_back(dynamic_cast<MctsNode*>(child.get()));
-	return children;
+MctsNode* MctsNode::makeRoot() {
+	// Every node is allocated before its children, so the blocks of the subtree are at higher indices than the node
+	// and their parents are at lower indices than them. Moving the blocks down in index order therefore never
+	// overwrites a block that is still to be moved, and each parent has been moved before its children.
+	std::vector<NodeIndex> blocks;
+	std::vector<MctsNode*> stack = {this};
+	while (!stack.empty()) {
+		MctsNode* node = stack.back();
+		stack.pop_back();
+		if (node->getChildren().empty()) continue;
+		blocks.push_back(node->firstChild);
+		for (MctsNode& child : node->children()) stack.push_back(&child);
+	}
+	std::sort(blocks.begin(), blocks.end());
+
+	// Depths are rebased on the new root. Each moved node tells its children where it went.
+	const int rootDepth = this->depth;
+	auto relocate = [rootDepth](const NodeIndex from, const NodeIndex to) {
+		MctsArena.relocate(from, to);
+		MctsNode& node = MctsArena[to];
+		node.depth -= rootDepth;
+		for (MctsNode& child : node.getChildren()) child.parent = to;
+	};
+
+	relocate(MctsArena.indexOf(this), 0);
+	MctsArena[0].parent = NULL_NODE;
+	NodeIndex next = 1;
+	for (const NodeIndex first : blocks) {
+		MctsNode& parent = MctsArena[MctsArena[first].parent];
+		const uint count = parent.childCount;
+		parent.firstChild = next;
+		for (uint offset = 0; offset < count; offset++)
+			relocate(first + offset, next + offset);
+		next += count;
+	}
+	MctsArena.shrink(next);
+	return &MctsArena[0];
 }
 
-float MctsNode::Ucb1() const {
-	if (this->visits == 0) return std::numeric_limits<float>::max();
-	return (value / static_cast<float>(visits)) + C *
-			std::sqrt(std::log(static_cast<float>(dynamic_cast<MctsNode*>(this->parent)->getVisits())) /
-			static_cast<float>(visits));
+void MctsNode::storePrincipalVariation(Position& pos) {
+	int moveCount = 0;
+	MctsNode* curr = this;
+	while (MctsNode* child = curr->mostVisitedChild()) {
+		if (child->getVisits() == 0) break;
+		TT.store(pos.getHash(), child->getInEdge(), child->getValue() / child->getVisits(), 0, BOUND_NONE);
+		pos.processMakeMove(child->getInEdge());
+		moveCount++;
+		curr = child;
+	}
+
+	while (moveCount-- > 0)
+		pos.processUndoMove();
 }
 
-void MctsNode::addChild(Move move) {
-	this->children.push_back(std::unique_ptr<MctsNode>(new MctsNode(this, move, this->getPos(), this->searchInfo)));
-}
\ No newline at end of file
+bool MctsNode::addChildren(const Move* moves, const uint count) {
+	const NodeIndex first = MctsArena.allocate(count);
+	if (first == NULL_NODE) return false;
+
+	const NodeIndex index = MctsArena.indexOf(this);
+	for (uint offset = 0; offset < count; offset++)
+		new (&MctsArena[first + offset]) MctsNode(index, moves[offset], this->depth + 1);
+	this->firstChild = first;
+	this->childCount = count;
+	return true;
+}
@@ -1,40 +1,266 @@
 #ifndef MCTS_HPP
 #define MCTS_HPP
 
+#include <cmath>
+#include <limits>
+
 #include "search.hpp"
 
-class Mcts : public BaseSearcher {
+const float C = std::sqrt(2);
+const uint VIRTUAL_LOSS = 3;
+const float ROLLOUT_EVAL_SCALE = 1000; // Centipawns at which a cut off rollout scores tanh(1), about 0.76.
+const size_t MAX_REUSE_PLIES = 2; // Plies that a position may be ahead of the last root for its tree to be reused.
+
+/**
+ * Expansion state of an MctsNode. Only one thread may expand a node, the others treat it as a leaf until the
+ * children have been published.
+ */
+enum ExpansionState : uint8_t {
+	UNEXPANDED, EXPANDING, EXPANDED
+};
+
+/**
+ * Columns of the MCTS node arena. The statistics of a node's children are contiguous so selection can scan them with
+ * vector loads.
+ */
+enum MctsColumn : size_t {
+	VALUE_COLUMN, VISITS_COLUMN, VIRTUAL_LOSS_COLUMN
+};
+
+/**
+ * @brief Calculate the UCB1 value of a child, given the log term of the parent, which is the same for all siblings.
+ *
+ * @param value Total value of the child from the perspective of the player that moved into it.
+ * @param visits Visit count of the child.
+ * @param logParentVisits Natural log of the visit count of the parent.
+ * @return UCB1 value. Unvisited children have the maximum value.
+ */
+inline float ucb1FromLog(const float value, const uint visits, const float logParentVisits) {
+	if (visits == 0) return std::numeric_limits<float>::max();
+	return (value / static_cast<float>(visits)) + C * std::sqrt(logParentVisits / static_cast<float>(visits));
+}
+
+/**
+ * @brief Calculate the UCB1 value of a child.
+ *
+ * @param value Total value of the child from the perspective of the player that moved into it.
+ * @param visits Visit count of the child.
+ * @param parentVisits Visit count of the parent.
+ * @return UCB1 value. Unvisited children have the maximum value.
+ */
+inline float ucb1(const float value, const uint visits, const uint parentVisits) {
+	return ucb1FromLog(value, visits, std::log(static_cast<float>(parentVisits)));
+}
+
+/**
+ * @brief Find the sibling with the highest UCB1 value, counting virtual loss as lost playouts. Vectorised with AVX2
+ * or SSE2 when available, else scalar.
+ *
+ * @param values Values of the siblings.
+ * @param visits Visit counts of the siblings.
+ * @param virtualLoss Virtual loss of the siblings.
+ * @param count Number of siblings. Must be at least 1.
+ * @param logParentVisits Natural log of the visit count (including virtual loss) of the parent.
+ * @return Offset of the sibling with the highest UCB1 value. The first is chosen on ties.
+ */
+uint ucb1Argmax(const float* values, const uint* visits, const uint* virtualLoss, const uint count,
+		const float logParentVisits);
+
+/**
+ * Plays random games from a position on a compact copy of the board. The copy keeps no history and does not track
+ * repetitions, and moves are chosen with the thread's own generator. Each worker owns one rollout.
+ */
+class Rollout {
 	public:
-		Mcts(Position& pos, const std::atomic_bool& searchTree, const SicarioConfigs& sicarioConfigs) :
-				BaseSearcher(pos, searchTree, sicarioConfigs) {}
+		/**
+		 * @brief Initialise the rollout.
+		 *
+		 * @param plyCap Number of plies after which the game is cut off and scored by the evaluation. 0 plays every
+		 * game to the end.
+		 */
+		Rollout(const uint plyCap) : plyCap(plyCap) {}
+
+		/**
+		 * @brief Play a random game from the position.
+		 *
+		 * @param pos Position to play from. Is not modified.
+		 * @return Result from the perspective of the player to move in the position.
+		 */
+		float play(const Position& pos);
+
+	private:
+		Position position;
+		const uint plyCap;
+};
+
+class MctsNode;
+
+typedef NodeArena<MctsNode, float, uint, uint> MctsNodeArena;
+
+/**
+ * Node storage for the Monte Carlo tree. Sized from the Hash option alongside the transposition table.
+ */
+extern MctsNodeArena MctsArena;
+
+class Mcts : public BaseSearcher<Mcts> {
+	public:
+		Mcts(const Position& root, SearchState& state, std::atomic_bool& searchTree, const TimeManager& timeManager,
+				const SicarioConfigs& sicarioConfigs) : BaseSearcher(root, state, searchTree, timeManager,
+				sicarioConfigs) {}
 		void search();
+
+		/**
+		 * @brief Send the best move over the roots of the last search.
+		 */
+		void sendBestMove();
+
+		/**
+		 * @brief Get the number of playouts run by the last search, summed over all workers.
+		 *
+		 * @return Number of playouts.
+		 */
+		inline uint64_t getPlayouts() const {
+			return this->playouts.load(std::memory_order_relaxed);
+		}
+
+	private:
+		static Hash treeRootHash; // Hash of the root position of the tree left in MctsArena by the last search.
+		std::vector<MctsNode*> roots; // One per worker under root parallelism, else just the shared root.
+
+		/**
+		 * @brief Find the node of the search position in the tree of the last search, if the position is the root of
+		 * that tree or at most MAX_REUSE_PLIES after it, and make it the root.
+		 *
+		 * @return The root to continue searching from, or nullptr if the tree cannot be reused.
+		 */
+		MctsNode* reuseTree();
+
+		/**
+		 * @brief Run playouts on the tree until the search is stopped. The search also stops at the soft time limit,
+		 * once the playouts of all workers reach the node limit, or once the tree reaches the depth limit.
+		 *
+		 * @param root Root of the tree to search. May be shared with other workers.
+		 * @param pos Root position, owned by the worker. Is restored before returning.
+		 * @param id Index of the worker. Only the first worker reports search information.
+		 */
+		void work(MctsNode* root, Position& pos, const uint id);
+
+		std::atomic<uint64_t> playouts = 0;
+		std::atomic_bool stopped = false; // Set by the first worker to reach a limit of the search.
 };
 
-class MctsNode : public BaseNode {
+class MctsNode : public BaseNode<MctsNode> {
 	public:
-		MctsNode(MctsNode* parent, Move move, Position& pos, SearchInfo& searchInfo);
+		MctsNode() = default;
+		MctsNode(NodeIndex parent, Move move, int depth);
 		MctsNode* bestChild();
-		MctsNode* select();
-		MctsNode* expand();
-		float simulate();
-		void rollback(float val);
-		const std::vector<MctsNode*> getChildren() const;
-		inline float getValue() { return this->value; }
-		inline uint getVisits() { return this->visits; }
-		float Ucb1() const;
+
+		/**
+		 * @brief Copy a node, for relocating it within the arena. Must not be used while the search is running.
+		 */
+		MctsNode& operator=(const MctsNode& node);
+
+		/**
+		 * @brief Descend the tree by UCB1, making the moves on the position and applying virtual loss to every node
+		 * passed through.
+		 *
+		 * @param pos Position of the calling worker. Must correspond to this node.
+		 * @return The leaf node reached.
+		 */
+		MctsNode* select(Position& pos);
+
+		/**
+		 * @brief Expand the node if it has been visited before and no other thread is expanding it. All children are
+		 * allocated from the arena as a single block. If the arena is full, the node is left as a leaf.
+		 *
+		 * @param pos Position of the calling worker. Must correspond to this node.
+		 * @return The child to simulate from, or this node if it was not expanded.
+		 */
+		MctsNode* expand(Position& pos);
+
+		/**
+		 * @brief Back the result up to the root, removing the virtual loss and undoing the moves made by select.
+		 *
+		 * @param val Result from the perspective of the player to move in this node's position.
+		 * @param pos Position of the calling worker. Is restored to the root position.
+		 */
+		void rollback(float val, Position& pos);
+
+		/**
+		 * @brief Get the children of the node.
+		 *
+		 * @return Span over the children, which is empty if the node has not been expanded.
+		 */
+		std::span<MctsNode> getChildren() const;
+		inline float getValue() const;
+		inline uint getVisits() const;
+
+		/**
+		 * @brief Get the child that has been visited the most.
+		 *
+		 * @return Pointer to the most visited child, or nullptr if the node has not been expanded.
+		 */
+		MctsNode* mostVisitedChild() const;
+
+		/**
+		 * @brief Get the child reached by a move.
+		 *
+		 * @param move Move of the child.
+		 * @return Pointer to the child, or nullptr if the node has not been expanded or has no such child.
+		 */
+		MctsNode* findChild(const Move move) const;
+
+		/**
+		 * @brief Make the node the root of the tree. Its subtree is moved to the front of the arena, keeping the order
+		 * of the blocks, and every other node is released. Must not be used while the search is running.
+		 *
+		 * @return The new root, which is the first node of the arena.
+		 */
+		MctsNode* makeRoot();
+
+		/**
+		 * @brief Store the most visited line of the tree in the transposition table so that later searches of the
+		 * same positions expand these moves first.
+		 *
+		 * @param pos Position corresponding to this node. Is restored before returning.
+		 */
+		void storePrincipalVariation(Position& pos);
+
+		static inline MctsNodeArena& arena() {
+			return MctsArena;
+		}
 
 	private:
-		float value = 0;
-		uint visits = 0;
+		std::atomic<ExpansionState> state = UNEXPANDED;
 
-		void addChild(Move move);
-		uint getVisits() const { return this->visits; }
+		/**
+		 * @brief Get a statistic of the node from the arena columns. Must be accessed through std::atomic_ref while
+		 * the search is running.
+		 *
+		 * @tparam Column Column of the statistic.
+		 * @return Reference to the statistic.
+		 */
+		template<MctsColumn Column>
+		inline auto& stat() const {
+			return MctsArena.column<Column>()[MctsArena.indexOf(this)];
+		}
 
-		struct Ucb1Comp {
-			bool operator()(const std::unique_ptr<BaseNode>& a, const std::unique_ptr<BaseNode>& b) const {
-				return dynamic_cast<MctsNode*>(a.get())->Ucb1() < dynamic_cast<MctsNode*>(b.get())->Ucb1();
-			}
-		};
+		/**
+		 * @brief Allocate and construct the children of the node.
+		 *
+		 * @param moves Moves of the children, in the order they are to be stored.
+		 * @param count Number of moves.
+		 * @return True if the children were added, or false if the arena is full.
+		 */
+		bool addChildren(const Move* moves, const uint count);
 };
 
-#endif
\ No newline at end of file
+inline float MctsNode::getValue() const {
+	return std::atomic_ref(this->stat<VALUE_COLUMN>()).load(std::memory_order_relaxed);
+}
+
+inline uint MctsNode::getVisits() const {
+	return std::atomic_ref(this->stat<VISITS_COLUMN>()).load(std::memory_order_relaxed);
+}
+
+#endif
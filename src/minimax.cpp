@@ -1,29 +1,192 @@
-#include <limits>
-#include <iostream>
+#include <algorithm>
 #include "minimax.hpp"
 #include "evaluate.hpp"
+#include "transposition.hpp"
+#include "uci.hpp"
 
 void MiniMax::search() {
-	float minInfinity = std::numeric_limits<float>::min();
-	float maxInfinity = std::numeric_limits<float>::max();
-	int depth = 5;
-	float val = evaluate(pos, depth, minInfinity, maxInfinity, pos.getTurn());
-}
-
-float MiniMax::evaluate(Position& pos, int depth, float alpha, float beta, Player player) {
-	MoveList moves = MoveList(pos);
-	if (depth == 0) return Evaluator::evaluate(pos, moves);
-
-	float maxEval = std::numeric_limits<float>::min();
-	float minEval = std::numeric_limits<float>::max();
-
-	for (Move move : moves) {
-		pos.processMakeMove(move);
-		float eval = this->evaluate(pos, depth - 1, alpha, beta, !player);
-		pos.processUndoMove();
-		player == WHITE ? maxEval = std::max(maxEval, eval) : minEval = std::min(minEval, eval);
-		player == WHITE ? alpha = std::max(alpha, eval) : beta = std::min(beta, eval);
-		if (beta <= alpha) break;
+	// The killers and history of earlier searches are kept, with the history halved so that this search's cut-offs
+	// soon outweigh them.
+	this->state.nodes = 0;
+	this->state.ageHistory();
+	this->stopped = false;
+
+	// Fall back to the first legal move if not even the first iteration completes.
+	MoveList rootMoves(this->pos);
+	this->bestMove = rootMoves.size() > 0 ? *rootMoves.begin() : NULL_MOVE;
+	this->ponderMove = NULL_MOVE;
+	int value = 0;
+	const int maxDepth = this->timeManager.getDepthLimit() > 0 ? std::min(this->timeManager.getDepthLimit(), MAX_PLY) :
+			MAX_PLY;
+	for (int depth = 1; depth <= maxDepth && this->bestMove != NULL_MOVE; depth++) {
+		const int iterationValue = aspirationSearch(depth, value);
+		if (this->stopped) break;
+
+		value = iterationValue;
+		this->bestMove = this->pv[0][0];
+		this->ponderMove = this->pvLength[0] >= 2 ? this->pv[0][1] : NULL_MOVE;
+		if (this->report) {
+			Uci::sendIterationInfo(depth, value, this->state.nodes, this->timeManager.elapsed(),
+					std::vector<Move>(this->pv[0], this->pv[0] + this->pvLength[0]));
+		}
+
+		// An iteration takes several times as long as the last, so do not start one that would likely be cut short.
+		if (this->timeManager.softLimitReached()) break;
+	}
+}
+
+void MiniMax::sendBestMove() {
+	const bool ponder = this->sicarioConfigs.options[PONDER].value == "true";
+	Uci::sendBestMove(this->bestMove, ponder ? this->ponderMove : NULL_MOVE);
+}
+
+int MiniMax::aspirationSearch(const int depth, const int previous) {
+	if (depth < ASPIRATION_DEPTH) return evaluate(depth, -INFINITE_VALUE, INFINITE_VALUE, 0);
+
+	// Widen the failed side of the window until the value falls inside it.
+	int window = ASPIRATION_WINDOW;
+	int alpha = previous - window;
+	int beta = previous + window;
+	while (true) {
+		const int value = evaluate(depth, alpha, beta, 0);
+		if (this->stopped) return value;
+
+		window *= 2;
+		if (value <= alpha) {
+			alpha = std::max(value - window, -INFINITE_VALUE);
+		} else if (value >= beta) {
+			beta = std::min(value + window, INFINITE_VALUE);
+		} else {
+			return value;
+		}
 	}
-	return player == WHITE ? maxEval : minEval;
-}
\ No newline at end of file
+}
+
+int MiniMax::evaluate(int depth, int alpha, int beta, const int ply) {
+	this->pvLength[ply] = ply;
+	if (ply > 0 && this->pos.isDrawn()) return DRAW_VALUE;
+	if (depth <= 0 || ply >= MAX_PLY) return quiescence(alpha, beta, ply);
+	if (visit()) return DRAW_VALUE;
+
+	// Bounds from earlier iterations (or searches) can end the search early, except on the principal variation so
+	// that its line is kept whole. MCTS entries carry only a move.
+	const bool pvNode = beta - alpha > NULL_WINDOW;
+	TTData ttData;
+	Move ttMove = NULL_MOVE;
+	if (TT.probe(this->pos.getHash(), ttData)) {
+		ttMove = ttData.move;
+		const int ttValue = valueFromTT(static_cast<int>(ttData.value), ply);
+		if (!pvNode && ttData.bound != BOUND_NONE && ttData.depth >= depth) {
+			if (ttData.bound == BOUND_EXACT) return ttValue;
+			if (ttData.bound == BOUND_LOWER && ttValue >= beta) return ttValue;
+			if (ttData.bound == BOUND_UPPER && ttValue <= alpha) return ttValue;
+		}
+	}
+
+	MovePicker picker(this->pos, ttMove, this->state.killers[ply], this->state.history);
+	const int alphaOrig = alpha;
+	int bestValue = -INFINITE_VALUE;
+	Move bestMove = NULL_MOVE;
+	uint searched = 0;
+	for (Move move = picker.next(); move != NULL_MOVE; move = picker.next()) {
+		this->pos.processMakeMove(move);
+		int value;
+		if (searched++ == 0) {
+			value = -evaluate(depth - 1, -beta, -alpha, ply + 1);
+		} else {
+			// Prove the move is no better than the best so far, and search it properly only if it is.
+			value = -evaluate(depth - 1, -alpha - NULL_WINDOW, -alpha, ply + 1);
+			if (value > alpha && value < beta) value = -evaluate(depth - 1, -beta, -alpha, ply + 1);
+		}
+		this->pos.processUndoMove();
+		if (this->stopped) return DRAW_VALUE;
+
+		if (value > bestValue) {
+			bestValue = value;
+			bestMove = move;
+		}
+		if (value > alpha) {
+			alpha = value;
+			updatePrincipalVariation(ply, move);
+		}
+		if (alpha >= beta) {
+			if (!this->pos.isCapture(move)) updateQuietCutoff(move, depth, ply);
+			break;
+		}
+	}
+	if (searched == 0) return terminalValue(this->pos.isEOGIgnoringRepetition(picker.getMoveList()), ply);
+
+	Bound bound = bestValue >= beta ? BOUND_LOWER : bestValue > alphaOrig ? BOUND_EXACT : BOUND_UPPER;
+	TT.store(this->pos.getHash(), bound == BOUND_UPPER ? NULL_MOVE : bestMove, valueToTT(bestValue, ply), depth,
+			bound);
+	return bestValue;
+}
+
+int MiniMax::quiescence(int alpha, const int beta, const int ply) {
+	this->pvLength[ply] = ply;
+	if (visit()) return DRAW_VALUE;
+
+	MovePicker picker(this->pos);
+	MoveList& moveList = picker.getMoveList();
+	if (moveList.size() == 0) return terminalValue(this->pos.isEOGIgnoringRepetition(moveList), ply);
+
+	// Standing pat assumes some quiet move keeps the evaluation, which need not hold in check. There every evasion
+	// is searched instead (see MovePicker), and the value is the best of them.
+	int bestValue = -INFINITE_VALUE;
+	if (!this->pos.inCheck() || ply >= MAX_PLY) {
+		const int evaluation = Evaluator::staticEvaluation(this->pos);
+		const int standPat = this->pos.getTurn() == WHITE ? evaluation : -evaluation;
+		if (standPat >= beta || ply >= MAX_PLY) return standPat;
+		alpha = std::max(alpha, standPat);
+		bestValue = standPat;
+	}
+
+	for (Move move = picker.next(); move != NULL_MOVE; move = picker.next()) {
+		this->pos.processMakeMove(move);
+		const int value = -quiescence(-beta, -alpha, ply + 1);
+		this->pos.processUndoMove();
+		if (this->stopped) return DRAW_VALUE;
+
+		bestValue = std::max(bestValue, value);
+		if (value > alpha) {
+			alpha = value;
+			updatePrincipalVariation(ply, move);
+		}
+		if (alpha >= beta) break;
+	}
+	return bestValue;
+}
+
+int MiniMax::terminalValue(const ExitCode code, const int ply) const {
+	if (code == WHITE_WINS || code == BLACK_WINS) return -MATE_VALUE + ply;
+	return DRAW_VALUE;
+}
+
+bool MiniMax::visit() {
+	const uint64_t nodes = ++this->state.nodes;
+	if (!this->searchTree.load(std::memory_order_relaxed) || this->timeManager.nodeLimitReached(nodes))
+		this->stopped = true;
+	else if (nodes % TIME_CHECK_NODES == 0 && this->timeManager.hardLimitReached())
+		this->stopped = true;
+	return this->stopped;
+}
+
+void MiniMax::updatePrincipalVariation(const int ply, const Move move) {
+	this->pv[ply][ply] = move;
+	for (int next = ply + 1; next < this->pvLength[ply + 1]; next++)
+		this->pv[ply][next] = this->pv[ply + 1][next];
+	this->pvLength[ply] = this->pvLength[ply + 1];
+}
+
+void MiniMax::updateQuietCutoff(const Move move, const int depth, const int ply) {
+	Move* killers = this->state.killers[ply];
+	if (killers[0] != move) {
+		std::copy_backward(killers, killers + KILLER_COUNT - 1, killers + KILLER_COUNT);
+		killers[0] = move;
+	}
+
+	// Halve every entry once one grows too large, so that recent cut-offs keep their weight.
+	int& entry = this->state.history[this->pos.getTurn()][start(move)][end(move)];
+	entry += depth * depth;
+	if (entry >= HISTORY_LIMIT) this->state.ageHistory();
+}
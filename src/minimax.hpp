@@ -1,14 +1,156 @@
 #ifndef MINIMAX_HPP
 #define MINIMAX_HPP
 
+#include <vector>
+
 #include "search.hpp"
+#include "movepicker.hpp"
+
+const int MATE_VALUE = 100000;
+const int MATE_BOUND = MATE_VALUE - MAX_PLY; // Values beyond this are mates, with the distance in plies encoded.
+const int INFINITE_VALUE = MATE_VALUE + 1;
+const int DRAW_VALUE = 0;
+const int NULL_WINDOW = 1;
+const int ASPIRATION_DEPTH = 4; // Iterations from this depth search a window around the previous value.
+const int ASPIRATION_WINDOW = 50;
 
-class MiniMax : public BaseSearcher {
+/**
+ * Iterative deepening principal variation search. Each iteration is an alpha-beta search to a fixed depth that
+ * searches the first move of every node with the full window and the rest with a null window, re-searching only the
+ * moves that beat it. Moves are ordered by a MovePicker, fed by killer moves and a history of quiet cut-offs that are
+ * kept in the SearchState of the thread, so they carry over from earlier searches. Leaves are resolved by a capture
+ * only quiescence search. Iterations from ASPIRATION_DEPTH start with a narrow window around the previous value,
+ * widening it on failure. The search runs until it is stopped or reaches a limit of its TimeManager, and reports every
+ * completed iteration.
+ *
+ * Values are in centipawns from the perspective of the player to move.
+ */
+class MiniMax : public BaseSearcher<MiniMax> {
 	public:
-		MiniMax(Position& pos, const std::atomic_bool& searchTree, const SicarioConfigs& sicarioConfigs) :
-				BaseSearcher(pos, searchTree, sicarioConfigs) {}
+		MiniMax(const Position& root, SearchState& state, std::atomic_bool& searchTree, const TimeManager& timeManager,
+				const SicarioConfigs& sicarioConfigs) : BaseSearcher(root, state, searchTree, timeManager,
+				sicarioConfigs) {}
+
+		/**
+		 * @brief Search the root position until stopped or out of time, nodes or depth.
+		 */
 		void search();
-		float evaluate(Position& pos, int depth, float alpha, float beta, Player player);
+
+		/**
+		 * @brief Send the best move of the last completed iteration, with the reply from its principal variation if the
+		 * Ponder option is on.
+		 */
+		void sendBestMove();
+
+		/**
+		 * @brief Get the number of nodes searched, including quiescence nodes.
+		 *
+		 * @return Number of nodes.
+		 */
+		inline uint64_t getNodes() const {
+			return this->state.nodes;
+		}
+
+	private:
+		bool stopped = false;
+		Move bestMove = NULL_MOVE;
+		Move ponderMove = NULL_MOVE; // Reply to the best move in the principal variation of the same iteration.
+
+		// Triangular principal variation table. Row ply holds the best line found from the node at that ply.
+		Move pv[MAX_PLY + 1][MAX_PLY + 1];
+		int pvLength[MAX_PLY + 1];
+
+		/**
+		 * @brief Search the root to a fixed depth, starting from a window around the value of the previous iteration.
+		 *
+		 * @param depth Depth to search to.
+		 * @param previous Value of the previous iteration.
+		 * @return Value of the root.
+		 */
+		int aspirationSearch(const int depth, const int previous);
+
+		/**
+		 * @brief Principal variation search of the current position.
+		 *
+		 * @param depth Remaining depth. The quiescence search is run once it reaches 0.
+		 * @param alpha Lower bound of the window.
+		 * @param beta Upper bound of the window.
+		 * @param ply Distance from the root.
+		 * @return Value of the position, or a bound on it if it is outside the window.
+		 */
+		int evaluate(int depth, int alpha, int beta, const int ply);
+
+		/**
+		 * @brief Search only the captures of the current position until it is quiet. The player to move may instead
+		 * stand pat on the static evaluation.
+		 *
+		 * @param alpha Lower bound of the window.
+		 * @param beta Upper bound of the window.
+		 * @param ply Distance from the root.
+		 * @return Value of the position, or a bound on it if it is outside the window.
+		 */
+		int quiescence(int alpha, const int beta, const int ply);
+
+		/**
+		 * @brief Get the value of a position with no moves.
+		 *
+		 * @param code End of game state of the position.
+		 * @param ply Distance from the root.
+		 * @return Value of being mated at the ply, or a draw.
+		 */
+		int terminalValue(const ExitCode code, const int ply) const;
+
+		/**
+		 * @brief Count the node and check if the search has been stopped or has reached its node or hard time limit.
+		 * The clock is only read every TIME_CHECK_NODES nodes.
+		 *
+		 * @return True if the search should return, else false.
+		 */
+		bool visit();
+
+		/**
+		 * @brief Set the principal variation of a ply to a move followed by the principal variation of the next ply.
+		 *
+		 * @param ply Ply of the move.
+		 * @param move Best move of the ply.
+		 */
+		void updatePrincipalVariation(const int ply, const Move move);
+
+		/**
+		 * @brief Record a quiet move that caused a cut-off as a killer of its ply and in the history.
+		 *
+		 * @param move Move that caused the cut-off.
+		 * @param depth Remaining depth of the node.
+		 * @param ply Ply of the node.
+		 */
+		void updateQuietCutoff(const Move move, const int depth, const int ply);
 };
 
-#endif
\ No newline at end of file
+/**
+ * @brief Convert a value to be stored in the transposition table. Mate values are stored as the distance from the
+ * node rather than from the root, so they stay correct when the node is reached at a different ply.
+ *
+ * @param value Value of the node.
+ * @param ply Ply of the node.
+ * @return Value to store.
+ */
+inline int valueToTT(const int value, const int ply) {
+	if (value >= MATE_BOUND) return value + ply;
+	if (value <= -MATE_BOUND) return value - ply;
+	return value;
+}
+
+/**
+ * @brief Convert a value read from the transposition table back to the distance from the root. Inverse of valueToTT.
+ *
+ * @param value Stored value.
+ * @param ply Ply of the node.
+ * @return Value of the node.
+ */
+inline int valueFromTT(const int value, const int ply) {
+	if (value >= MATE_BOUND) return value - ply;
+	if (value <= -MATE_BOUND) return value + ply;
+	return value;
+}
+
+#endif
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <iostream>
 #include <cmath>
+#include <random>
 
 #include "movegen.hpp"
 #include "game.hpp"
@@ -84,14 +85,6 @@ MoveFamilies computeKnightMoves() {
 	return knightMoves;
 }
 
-std::array<MoveFamilies, PLAYER_COUNT> computePawnMoves() {
-	std::array<MoveFamilies, PLAYER_COUNT> pawnMoves = {
-		computePawnMovesBySide(BLACK),
-		computePawnMovesBySide(WHITE)
-	};
-	return pawnMoves;
-}
-
 MoveFamilies computePawnMovesBySide(const Player player) {
 	MoveFamilies pawnMoves;
 	for (Square square = A2; square <= H7; square++) {
@@ -693,4 +686,42 @@ std::vector<std::array<int, 4>> getEndBlockSquares(std::array<int, 4> sizes) {
 	generatePairSquares({0, 0, sizes[2], sizes[3]}, {0, 0, 0, 0}, res);
 	generatePairSquares({sizes[0], 0, 0, sizes[3]}, {0, 0, 0, 0}, res);
 	return res;
-}
\ No newline at end of file
+}
+
+std::array<std::array<Hash, SQUARE_COUNT>, PIECE_TYPE_COUNT> generatePieceHashes() {
+	std::default_random_engine generator(42); // Fixed random seed
+	std::uniform_int_distribution<uint64_t> distribution(0, MAX_BB);
+	std::array<std::array<Hash, SQUARE_COUNT>, PIECE_TYPE_COUNT> hashes;
+	for (uint piece = 0; piece < PIECE_TYPE_COUNT; piece++) {
+		for (Square square = A1; square <= H8; square++) {
+			hashes[piece][square] = distribution(generator);
+		}
+	}
+	return hashes;
+}
+
+Hash generateTurnHash() {
+	std::default_random_engine generator(314); // Fixed random seed
+	std::uniform_int_distribution<uint64_t> distribution(0, MAX_BB);
+	return distribution(generator);
+}
+
+std::array<Hash, CASTLING_COMBOS> generateCastlingHash() {
+	std::default_random_engine generator(272); // Fixed random seed
+	std::uniform_int_distribution<uint64_t> distribution(0, MAX_BB);
+	std::array<Hash, CASTLING_COMBOS> hashes;
+	for (uint i = 0; i < CASTLING_COMBOS; i++) {
+		hashes[i] = distribution(generator);
+	}
+	return hashes;
+}
+
+std::array<Hash, FILE_COUNT> generateEnPassantHash() {
+	std::default_random_engine generator(162); // Fixed random seed
+	std::uniform_int_distribution<uint64_t> distribution(0, MAX_BB);
+	std::array<Hash, FILE_COUNT> hashes;
+	for (uint i = 0; i < FILE_COUNT; i++) {
+		hashes[i] = distribution(generator);
+	}
+	return hashes;
+}
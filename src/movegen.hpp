@@ -12,6 +12,72 @@
 #include "constants.hpp"
 #include "bitboard.hpp"
 #include "utils.hpp"
+#include "tables.hpp"
+
+/**
+ * Packs families of sets (a list of sets per square) into one flat array of values and one array of (offset, length)
+ * spans, as read by SetTable. Both arrays are ordered by square first, so the sets of every family for a given square
+ * sit next to each other. Used to generate the tables at build time.
+ *
+ * @tparam T Type of the values.
+ */
+template<typename T>
+class SetPool {
+	public:
+		typedef std::array<std::vector<std::vector<T>>, SQUARE_COUNT> Family;
+
+		/**
+		 * @brief Pack the families.
+		 *
+		 * @param families Families to pack.
+		 */
+		SetPool(const std::vector<Family>& families) : rows(families.size()) {
+			for (Square square = A1; square <= H8; square++) {
+				for (uint index = 0; index < families.size(); index++) {
+					this->rows[index][square] = this->spans.size();
+					for (const std::vector<T>& set : families[index][square]) {
+						this->spans.push_back({static_cast<uint32_t>(this->values.size()),
+								static_cast<uint32_t>(set.size())});
+						this->values.insert(this->values.end(), set.begin(), set.end());
+					}
+				}
+			}
+		}
+
+		inline const std::vector<T>& getValues() const {
+			return this->values;
+		}
+
+		inline const std::vector<TableSpan>& getSpans() const {
+			return this->spans;
+		}
+
+		/**
+		 * @brief Get the row of a family on a square.
+		 *
+		 * @param family Position of the family in the families the pool was constructed with.
+		 * @param square Square of the row.
+		 * @return Index of the span of the first set of the row.
+		 */
+		inline uint32_t getRow(const uint family, const Square square) const {
+			return this->rows[family][square];
+		}
+
+	private:
+		std::vector<T> values;
+		std::vector<TableSpan> spans;
+		std::vector<std::array<uint32_t, SQUARE_COUNT>> rows;
+};
+
+typedef SetPool<Move> MovePool;
+
+/**
+ * Families of the move pool, in the order they are packed.
+ */
+enum MoveTableIndex : uint {
+	KING_MOVES, ROOK_MOVES, BISHOP_MOVES, KNIGHT_MOVES, BLACK_PAWN_MOVES, WHITE_PAWN_MOVES, ROOK_BLOCK_MOVES,
+	BISHOP_BLOCK_MOVES
+};
 
 /**
  * @brief Compute move sets of the king on each square based on legal destinations. This does not compute castling
@@ -42,13 +108,6 @@ MoveFamilies computeBishopMoves();
  */
 MoveFamilies computeKnightMoves();
 
-/**
- * @brief Makes calls to computePawnMovesBySide to create the pawn moves arrays. Black array is 0, white array is 1.
- *
- * @return Array of array of vectors of move vectors.
- */
-std::array<MoveFamilies, PLAYER_COUNT> computePawnMoves();
-
 /**
  * @brief Compute move sets of the pawn on each square based of legal destinations for a particular side. Does not
  * compute en-passant moves.
@@ -325,6 +384,35 @@ void generatePairSquares(std::array<int, 4> sizes, std::array<int, 4> curr, std:
  */
 std::vector<std::array<int, 4>> getEndBlockSquares(std::array<int, 4> sizes);
 
+/**
+ * @brief Generate zobrist piece hashes using a predefined seed.
+ *
+ * @return Array of size 12 (each piece for each colour) containing arrays of size SQUARE_COUNT Hashes.
+ */
+std::array<std::array<Hash, SQUARE_COUNT>, PIECE_TYPE_COUNT> generatePieceHashes();
+
+/**
+ * @brief Generate zobrist hashes for the turn using predefined seed.
+ *
+ * @return Hash representing turn.
+ */
+Hash generateTurnHash();
+
+/**
+ * @brief Generate zobrist hashes for different castling permissions combinations using a predefined seed.
+ *
+ * @return Array of size 16 (the number of possible castling permission combinations) of Hashes.
+ */
+std::array<Hash, CASTLING_COMBOS> generateCastlingHash();
+
+/**
+ * @brief Generate zobrist hashes for en passant file using predefined seed. The colour of the player who can capture
+ * en-passant is taken care of by the turn hash.
+ *
+ * @return Array of size 8 (number of files) of Hashes.
+ */
+std::array<Hash, FILE_COUNT> generateEnPassantHash();
+
 /**
  * Information before current move is made. In the Position class, the 'history' contains structs of type History. The
  * last entry is described by this struct.
@@ -0,0 +1,128 @@
+#include <algorithm>
+
+#include "movepicker.hpp"
+
+int orderingValue(const PieceType piece) {
+	switch (piece) {
+		case W_PAWN:
+		case B_PAWN:
+			return 1;
+		case W_KNIGHT:
+		case B_KNIGHT:
+			return 2;
+		case W_BISHOP:
+		case B_BISHOP:
+			return 3;
+		case W_ROOK:
+		case B_ROOK:
+			return 4;
+		case W_QUEEN:
+		case B_QUEEN:
+			return 5;
+		case W_KING:
+		case B_KING:
+			return 6;
+		default: // NO_PIECE
+			return 0;
+	}
+}
+
+MovePicker::MovePicker(Position& pos, const Move hashMove, const Move killers[KILLER_COUNT],
+		const ButterflyHistory& history) : pos(pos), hashMove(hashMove), history(&history), capturesOnly(false),
+		stage(HASH_MOVE_STAGE) {
+	std::copy(killers, killers + KILLER_COUNT, this->killers);
+}
+
+MovePicker::MovePicker(Position& pos) : pos(pos), hashMove(NULL_MOVE), history(nullptr), capturesOnly(true),
+		stage(GENERATE_STAGE) {}
+
+Move MovePicker::next() {
+	switch (this->stage) {
+		case HASH_MOVE_STAGE:
+			this->stage = GENERATE_STAGE;
+
+			// A hash collision or a racing write can give a move of another position, and playing an illegal move
+			// would corrupt the position, so the move is checked against the position first. A rejected move is
+			// forgotten, so that it is not skipped by the later stages.
+			if (this->hashMove != NULL_MOVE) {
+				if (this->pos.isLegal(this->hashMove)) return this->hashMove;
+				this->hashMove = NULL_MOVE;
+			}
+			[[fallthrough]];
+		case GENERATE_STAGE:
+			generate();
+			this->stage = CAPTURE_STAGE;
+			[[fallthrough]];
+		case CAPTURE_STAGE:
+			if (this->current < this->captureEnd) return pickBest(this->captureEnd);
+			if (this->capturesOnly) {
+				this->stage = DONE_STAGE;
+				return NULL_MOVE;
+			}
+			this->stage = KILLER_STAGE;
+			[[fallthrough]];
+		case KILLER_STAGE:
+			// Killers are only played if they are quiet moves of this position, so they are taken from the quiets.
+			while (this->killerIndex < KILLER_COUNT) {
+				const Move killer = this->killers[this->killerIndex++];
+				if (killer == NULL_MOVE || killer == this->hashMove) continue;
+
+				Move* found = std::find(this->moves + this->current, this->moves + this->moveCount, killer);
+				if (found == this->moves + this->moveCount) continue;
+				std::iter_swap(this->moves + this->current, found);
+				return this->moves[this->current++];
+			}
+
+			// Score the remaining quiets now that the killers are out of the way.
+			for (uint index = this->current; index < this->moveCount; index++) {
+				const Move move = this->moves[index];
+				this->scores[index] = this->history ? (*this->history)[this->pos.getTurn()][start(move)][end(move)] : 0;
+			}
+			this->stage = QUIET_STAGE;
+			[[fallthrough]];
+		case QUIET_STAGE:
+			if (this->current < this->moveCount) return pickBest(this->moveCount);
+			this->stage = DONE_STAGE;
+			[[fallthrough]];
+		case DONE_STAGE:
+			return NULL_MOVE;
+	}
+	return NULL_MOVE;
+}
+
+MoveList& MovePicker::getMoveList() {
+	if (!this->moveList) this->moveList.emplace(this->pos);
+	return *this->moveList;
+}
+
+void MovePicker::generate() {
+	MoveList& moveList = getMoveList();
+
+	// The quiescence search can not stand pat in check, so it needs every evasion rather than just the captures.
+	if (this->pos.inCheck()) this->capturesOnly = false;
+
+	// Captures first, scored by MVV-LVA. En-passant captures a pawn that is not on the destination square.
+	for (Move move : moveList) {
+		if (move == this->hashMove || !this->pos.isCapture(move)) continue;
+		const PieceType victim = type(move) == EN_PASSANT ? W_PAWN : this->pos.getPiece(end(move));
+		this->scores[this->moveCount] = orderingValue(victim) * 8 - orderingValue(this->pos.getPiece(start(move)));
+		this->moves[this->moveCount++] = move;
+	}
+	this->captureEnd = this->moveCount;
+	if (this->capturesOnly) return;
+
+	for (Move move : moveList) {
+		if (move == this->hashMove || this->pos.isCapture(move)) continue;
+		this->moves[this->moveCount++] = move;
+	}
+}
+
+Move MovePicker::pickBest(const uint end) {
+	// A partial selection sort, since a cut-off usually comes before most moves are taken.
+	uint best = this->current;
+	for (uint index = this->current + 1; index < end; index++)
+		if (this->scores[index] > this->scores[best]) best = index;
+	std::swap(this->moves[this->current], this->moves[best]);
+	std::swap(this->scores[this->current], this->scores[best]);
+	return this->moves[this->current++];
+}
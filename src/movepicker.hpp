@@ -0,0 +1,106 @@
+#ifndef MOVEPICKER_HPP
+#define MOVEPICKER_HPP
+
+#include <optional>
+
+#include "game.hpp"
+
+const uint KILLER_COUNT = 2;
+const int HISTORY_LIMIT = 1 << 20; // The history table is halved when an entry reaches this.
+
+/**
+ * Butterfly history: how often a quiet move from a square to a square has caused a cut-off, weighted by depth.
+ */
+typedef int ButterflyHistory[PLAYER_COUNT][SQUARE_COUNT][SQUARE_COUNT];
+
+/**
+ * Stages of the MovePicker, in the order that they are run.
+ */
+enum PickerStage {
+	HASH_MOVE_STAGE, GENERATE_STAGE, CAPTURE_STAGE, KILLER_STAGE, QUIET_STAGE, DONE_STAGE
+};
+
+/**
+ * @brief Get the value of a piece for ordering captures, as the victim (most valuable first) or the attacker (least
+ * valuable first).
+ *
+ * @param piece Piece type.
+ * @return Ordering value. Kings are the most valuable.
+ */
+int orderingValue(const PieceType piece);
+
+/**
+ * Yields the moves of a position one at a time in the order most likely to cause a cut-off: the move from the
+ * transposition table, then captures by most valuable victim and least valuable attacker (MVV-LVA), then the killer
+ * moves of the ply, then the remaining quiet moves by their history. The hash move is checked for legality and played
+ * before any moves are generated, so a cut-off on it skips generation entirely. Otherwise the moves are generated once
+ * and each stage is sorted only as far as its moves are taken.
+ */
+class MovePicker {
+	public:
+		/**
+		 * @brief Initialise the picker for a node of the main search.
+		 *
+		 * @param pos Position to pick the moves of. Must not change while the picker is in use, other than moves that
+		 * are undone before the next call.
+		 * @param hashMove Move from the transposition table, or NULL_MOVE.
+		 * @param killers Killer moves of the ply.
+		 * @param history History of the searcher.
+		 */
+		MovePicker(Position& pos, const Move hashMove, const Move killers[KILLER_COUNT],
+				const ButterflyHistory& history);
+
+		/**
+		 * @brief Initialise the picker for a node of the quiescence search, which only yields captures, or every
+		 * evasion when in check.
+		 *
+		 * @param pos Position to pick the moves of.
+		 */
+		MovePicker(Position& pos);
+
+		/**
+		 * @brief Get the next move.
+		 *
+		 * @return The next move, or NULL_MOVE once every move has been yielded.
+		 */
+		Move next();
+
+		/**
+		 * @brief Get all moves of the position, generating them if they have not been yet.
+		 *
+		 * @return MoveList of the position.
+		 */
+		MoveList& getMoveList();
+
+	private:
+		Position& pos;
+		Move hashMove;
+		Move killers[KILLER_COUNT] = {NULL_MOVE, NULL_MOVE};
+		const ButterflyHistory* history;
+		bool capturesOnly;
+		PickerStage stage;
+
+		// Moves are generated into a MoveList and copied here as the captures followed by the quiets.
+		std::optional<MoveList> moveList;
+		Move moves[MAX_MOVES];
+		int scores[MAX_MOVES];
+		uint captureEnd = 0;
+		uint moveCount = 0;
+		uint current = 0;
+		uint killerIndex = 0;
+
+		/**
+		 * @brief Generate the moves, split them into captures and quiets, and score the captures.
+		 */
+		void generate();
+
+		/**
+		 * @brief Move the highest scoring remaining move of a range to the front of the remainder and yield it.
+		 *
+		 * @param end End of the range.
+		 * @return The move.
+		 */
+		Move pickBest(const uint end);
+};
+
+#endif
@@ -0,0 +1,160 @@
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <fstream>
+
+#include "nnue.hpp"
+
+NnueNetwork Nnue;
+
+// Index of every piece type among the features seen by white: white pawn to king, then black pawn to king. Black sees
+// the colours swapped.
+const uint FEATURE_PIECE[PIECE_TYPE_COUNT] = { 11, 5, 4, 3, 2, 1, 0, 10, 9, 8, 7, 6 };
+const uint FEATURE_PIECES_PER_SIDE = BASE_PIECE_TYPE_COUNT;
+
+/**
+ * @brief Get the feature of a piece on a square from the perspective of a player.
+ *
+ * @param perspective Player whose view of the board to use.
+ * @param piece Piece type.
+ * @param square Square of the piece.
+ * @return Index of the feature.
+ */
+inline uint featureIndex(const Player perspective, const PieceType piece, const Square square) {
+	if (perspective == WHITE) return FEATURE_PIECE[piece] * SQUARE_COUNT + square;
+	const uint flipped = (FEATURE_PIECE[piece] + FEATURE_PIECES_PER_SIDE) % PIECE_TYPE_COUNT;
+	return flipped * SQUARE_COUNT + (square ^ 56); // Same as mirror(square).
+}
+
+inline void addColumn(int16_t* values, const int16_t* column) {
+	#if defined(__AVX2__)
+	for (uint index = 0; index < NNUE_HIDDEN_SIZE; index += 16) {
+		__m256i* value = reinterpret_cast<__m256i*>(values + index);
+		const __m256i weight = _mm256_load_si256(reinterpret_cast<const __m256i*>(column + index));
+		_mm256_store_si256(value, _mm256_add_epi16(_mm256_load_si256(value), weight));
+	}
+	#else
+	for (uint index = 0; index < NNUE_HIDDEN_SIZE; index++) values[index] += column[index];
+	#endif
+}
+
+inline void subtractColumn(int16_t* values, const int16_t* column) {
+	#if defined(__AVX2__)
+	for (uint index = 0; index < NNUE_HIDDEN_SIZE; index += 16) {
+		__m256i* value = reinterpret_cast<__m256i*>(values + index);
+		const __m256i weight = _mm256_load_si256(reinterpret_cast<const __m256i*>(column + index));
+		_mm256_store_si256(value, _mm256_sub_epi16(_mm256_load_si256(value), weight));
+	}
+	#else
+	for (uint index = 0; index < NNUE_HIDDEN_SIZE; index++) values[index] -= column[index];
+	#endif
+}
+
+inline void addSubtractColumns(int16_t* values, const int16_t* added, const int16_t* subtracted) {
+	#if defined(__AVX2__)
+	for (uint index = 0; index < NNUE_HIDDEN_SIZE; index += 16) {
+		__m256i* value = reinterpret_cast<__m256i*>(values + index);
+		const __m256i add = _mm256_load_si256(reinterpret_cast<const __m256i*>(added + index));
+		const __m256i subtract = _mm256_load_si256(reinterpret_cast<const __m256i*>(subtracted + index));
+		_mm256_store_si256(value, _mm256_sub_epi16(_mm256_add_epi16(_mm256_load_si256(value), add), subtract));
+	}
+	#else
+	for (uint index = 0; index < NNUE_HIDDEN_SIZE; index++) values[index] += added[index] - subtracted[index];
+	#endif
+}
+
+/**
+ * @brief Clip one perspective of the hidden layer to [0, NNUE_QA] and take its dot product with the output weights.
+ *
+ * @param values Hidden layer of the perspective.
+ * @param weights Output weights of the perspective.
+ * @return Dot product, quantised by NNUE_QA * NNUE_QB.
+ */
+inline int32_t activate(const int16_t* values, const int16_t* weights) {
+	#if defined(__AVX2__)
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i ceiling = _mm256_set1_epi16(NNUE_QA);
+	__m256i sum = _mm256_setzero_si256();
+	for (uint index = 0; index < NNUE_HIDDEN_SIZE; index += 16) {
+		__m256i value = _mm256_load_si256(reinterpret_cast<const __m256i*>(values + index));
+		value = _mm256_min_epi16(_mm256_max_epi16(value, zero), ceiling);
+		const __m256i weight = _mm256_load_si256(reinterpret_cast<const __m256i*>(weights + index));
+		sum = _mm256_add_epi32(sum, _mm256_madd_epi16(value, weight));
+	}
+	__m128i total = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+	total = _mm_add_epi32(total, _mm_shuffle_epi32(total, _MM_SHUFFLE(1, 0, 3, 2)));
+	total = _mm_add_epi32(total, _mm_shuffle_epi32(total, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(total);
+	#else
+	int32_t sum = 0;
+	for (uint index = 0; index < NNUE_HIDDEN_SIZE; index++) {
+		const int32_t value = std::min(std::max(static_cast<int32_t>(values[index]), 0), NNUE_QA);
+		sum += value * weights[index];
+	}
+	return sum;
+	#endif
+}
+
+bool NnueNetwork::load(const std::string& path) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file) return false;
+
+	uint32_t header[3];
+	file.read(reinterpret_cast<char*>(header), sizeof(header));
+	if (!file || header[0] != NNUE_VERSION || header[1] != NNUE_INPUT_SIZE || header[2] != NNUE_HIDDEN_SIZE)
+		return false;
+
+	std::unique_ptr<Weights> loaded = std::make_unique<Weights>();
+	file.read(reinterpret_cast<char*>(loaded->feature), sizeof(loaded->feature));
+	file.read(reinterpret_cast<char*>(loaded->bias), sizeof(loaded->bias));
+	file.read(reinterpret_cast<char*>(loaded->output), sizeof(loaded->output));
+	file.read(reinterpret_cast<char*>(&loaded->outputBias), sizeof(loaded->outputBias));
+	if (!file || file.peek() != std::ifstream::traits_type::eof()) return false;
+
+	this->weights = std::move(loaded);
+	return true;
+}
+
+void NnueNetwork::unload() {
+	this->weights.reset();
+}
+
+void NnueNetwork::refresh(NnueAccumulator& accumulator, const PieceType pieces[SQUARE_COUNT]) const {
+	for (Player perspective : {WHITE, BLACK}) {
+		std::copy(this->weights->bias, this->weights->bias + NNUE_HIDDEN_SIZE, accumulator.values[perspective]);
+		for (uint square = 0; square < SQUARE_COUNT; square++) {
+			if (pieces[square] == NO_PIECE) continue;
+			const uint feature = featureIndex(perspective, pieces[square], static_cast<Square>(square));
+			addColumn(accumulator.values[perspective], this->weights->feature[feature]);
+		}
+	}
+}
+
+void NnueNetwork::addFeature(NnueAccumulator& accumulator, const PieceType piece, const Square square) const {
+	for (Player perspective : {WHITE, BLACK})
+		addColumn(accumulator.values[perspective], this->weights->feature[featureIndex(perspective, piece, square)]);
+}
+
+void NnueNetwork::removeFeature(NnueAccumulator& accumulator, const PieceType piece, const Square square) const {
+	for (Player perspective : {WHITE, BLACK}) {
+		subtractColumn(accumulator.values[perspective],
+				this->weights->feature[featureIndex(perspective, piece, square)]);
+	}
+}
+
+void NnueNetwork::moveFeature(NnueAccumulator& accumulator, const PieceType piece, const Square start,
+		const Square end) const {
+	for (Player perspective : {WHITE, BLACK}) {
+		addSubtractColumns(accumulator.values[perspective],
+				this->weights->feature[featureIndex(perspective, piece, end)],
+				this->weights->feature[featureIndex(perspective, piece, start)]);
+	}
+}
+
+int NnueNetwork::evaluate(const NnueAccumulator& accumulator, const Player turn) const {
+	const int64_t output = static_cast<int64_t>(activate(accumulator.values[turn], this->weights->output)) +
+			activate(accumulator.values[!turn], this->weights->output + NNUE_HIDDEN_SIZE) + this->weights->outputBias;
+	return static_cast<int>(output * NNUE_SCALE / (NNUE_QA * NNUE_QB));
+}
@@ -0,0 +1,121 @@
+#ifndef NNUE_HPP
+#define NNUE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "constants.hpp"
+
+const uint32_t NNUE_VERSION = 1;
+const uint NNUE_INPUT_SIZE = PIECE_TYPE_COUNT * SQUARE_COUNT;
+const uint NNUE_HIDDEN_SIZE = 256;
+const int NNUE_QA = 255;    // Quantisation of the hidden layer. Activations are clipped to [0, NNUE_QA].
+const int NNUE_QB = 64;     // Quantisation of the output weights.
+const int NNUE_SCALE = 400; // Centipawns per unit of the unquantised output.
+
+/**
+ * The first layer of the network for the current position, from both perspectives. Each perspective is the hidden
+ * biases plus the weights of every active feature, so it is updated by adding and subtracting weight columns as pieces
+ * move rather than recomputed.
+ */
+struct NnueAccumulator {
+	alignas(32) int16_t values[PLAYER_COUNT][NNUE_HIDDEN_SIZE];
+};
+
+/**
+ * An efficiently updatable neural network evaluator. The input features are every (piece, square) pair seen from each
+ * side, with the board flipped for black so that both perspectives share the weights (768 features each). The two
+ * perspectives feed a clipped ReLU hidden layer of NNUE_HIDDEN_SIZE neurons each, ordered side to move first, then a
+ * single output neuron.
+ *
+ * Networks are read from a little-endian file of a header of three uint32 values (NNUE_VERSION, NNUE_INPUT_SIZE and
+ * NNUE_HIDDEN_SIZE) followed by int16 values: the feature weights in feature major order, the hidden biases, the
+ * output weights and the output bias.
+ *
+ * The kernels use AVX2 when it is enabled at compile time, else portable loops.
+ */
+class NnueNetwork {
+	public:
+		/**
+		 * @brief Load a network from a file. The current network is kept if the file cannot be read or is malformed.
+		 *
+		 * @param path Path of the network file.
+		 * @return True if the network was loaded, else false.
+		 */
+		bool load(const std::string& path);
+
+		/**
+		 * @brief Discard the network, returning the evaluation to the piece square tables.
+		 */
+		void unload();
+
+		/**
+		 * @brief Check if a network is loaded. Positions only maintain their accumulators while one is.
+		 *
+		 * @return True if a network is loaded, else false.
+		 */
+		inline bool isLoaded() const {
+			return this->weights != nullptr;
+		}
+
+		/**
+		 * @brief Recompute an accumulator from the pieces on the board.
+		 *
+		 * @param accumulator Accumulator to set.
+		 * @param pieces Piece on every square.
+		 */
+		void refresh(NnueAccumulator& accumulator, const PieceType pieces[SQUARE_COUNT]) const;
+
+		/**
+		 * @brief Add the features of a piece to an accumulator.
+		 *
+		 * @param accumulator Accumulator to update.
+		 * @param piece Piece type.
+		 * @param square Square of the piece.
+		 */
+		void addFeature(NnueAccumulator& accumulator, const PieceType piece, const Square square) const;
+
+		/**
+		 * @brief Remove the features of a piece from an accumulator.
+		 *
+		 * @param accumulator Accumulator to update.
+		 * @param piece Piece type.
+		 * @param square Square of the piece.
+		 */
+		void removeFeature(NnueAccumulator& accumulator, const PieceType piece, const Square square) const;
+
+		/**
+		 * @brief Move the features of a piece in an accumulator, in one pass over each perspective.
+		 *
+		 * @param accumulator Accumulator to update.
+		 * @param piece Piece type.
+		 * @param start Square the piece leaves.
+		 * @param end Square the piece arrives on.
+		 */
+		void moveFeature(NnueAccumulator& accumulator, const PieceType piece, const Square start, const Square end)
+				const;
+
+		/**
+		 * @brief Run the output layer on an accumulator.
+		 *
+		 * @param accumulator Accumulator of the position.
+		 * @param turn Player to move.
+		 * @return Evaluation in centipawns from the perspective of the player to move.
+		 */
+		int evaluate(const NnueAccumulator& accumulator, const Player turn) const;
+
+	private:
+		struct Weights {
+			alignas(32) int16_t feature[NNUE_INPUT_SIZE][NNUE_HIDDEN_SIZE];
+			alignas(32) int16_t bias[NNUE_HIDDEN_SIZE];
+			alignas(32) int16_t output[PLAYER_COUNT * NNUE_HIDDEN_SIZE];
+			int16_t outputBias;
+		};
+
+		std::unique_ptr<Weights> weights;
+};
+
+extern NnueNetwork Nnue;
+
+#endif
@@ -0,0 +1,153 @@
+#include <algorithm>
+
+#include "perft.hpp"
+#include "utils.hpp"
+#include "threadpool.hpp"
+
+// Runs at least this deep are split at the replies to the root moves rather than the root moves themselves, so that a
+// few large subtrees do not leave the other workers idle at the end.
+const int PERFT_SPLIT_DEPTH = 4;
+
+const uint PERFT_DEPTH_BITS = 8;
+const uint64_t PERFT_DEPTH_MASK = (1ULL << PERFT_DEPTH_BITS) - 1;
+
+PerftTable::PerftTable(const size_t megabytes) {
+	this->bucketCount = std::max(megabytes * 1024 * 1024 / sizeof(Bucket), static_cast<size_t>(1));
+	this->buckets = std::make_unique<Bucket[]>(this->bucketCount);
+	for (size_t bucket = 0; bucket < this->bucketCount; bucket++) {
+		for (Entry& entry : this->buckets[bucket].entries) {
+			entry.key.store(0, std::memory_order_relaxed);
+			entry.data.store(0, std::memory_order_relaxed);
+		}
+	}
+}
+
+bool PerftTable::probe(const Hash hash, const int depth, uint64_t& nodes) const {
+	for (const Entry& entry : this->buckets[hash % this->bucketCount].entries) {
+		uint64_t entryData = entry.data.load(std::memory_order_relaxed);
+		uint64_t entryKey = entry.key.load(std::memory_order_relaxed);
+		if ((entryKey ^ entryData) != hash || (entryData & PERFT_DEPTH_MASK) != static_cast<uint64_t>(depth)) continue;
+
+		nodes = entryData >> PERFT_DEPTH_BITS;
+		return true;
+	}
+	return false;
+}
+
+void PerftTable::store(const Hash hash, const int depth, const uint64_t nodes) {
+	Bucket& bucket = this->buckets[hash % this->bucketCount];
+	Entry* replace = &bucket.entries[0];
+	uint64_t replaceDepth = PERFT_DEPTH_MASK;
+	for (Entry& entry : bucket.entries) {
+		uint64_t entryData = entry.data.load(std::memory_order_relaxed);
+		uint64_t entryKey = entry.key.load(std::memory_order_relaxed);
+		uint64_t entryDepth = entryData & PERFT_DEPTH_MASK;
+
+		// Same position and depth, or an empty slot.
+		if (((entryKey ^ entryData) == hash && entryDepth == static_cast<uint64_t>(depth)) || entryData == 0) {
+			replace = &entry;
+			break;
+		}
+
+		// Otherwise replace the shallowest entry, which is the cheapest to recount.
+		if (entryDepth < replaceDepth) {
+			replaceDepth = entryDepth;
+			replace = &entry;
+		}
+	}
+
+	uint64_t data = nodes << PERFT_DEPTH_BITS | static_cast<uint64_t>(depth);
+	replace->key.store(hash ^ data, std::memory_order_relaxed);
+	replace->data.store(data, std::memory_order_relaxed);
+}
+
+uint64_t perft(Position& pos, const int depth, PerftTable* table) {
+	if (depth <= 0) return 1;
+
+	// The leaves are only counted, so their moves are never looked up.
+	if (depth == 1) return pos.countMoves();
+
+	// Depth 2 subtrees are cheaper to count than to look up.
+	uint64_t nodes = 0;
+	const bool cached = table != nullptr && depth > 2;
+	if (cached && table->probe(pos.getHash(), depth, nodes)) return nodes;
+
+	for (Move move : MoveList(pos)) {
+		pos.processMakeMove(move);
+		nodes += perft(pos, depth - 1, table);
+		pos.processUndoMove();
+	}
+
+	if (cached) table->store(pos.getHash(), depth, nodes);
+	return nodes;
+}
+
+Perft::Perft(const Position& pos, PerftTable* table) : pos(pos), threads(std::max(1U, Threads.size())),
+		table(table) {}
+
+uint64_t Perft::run(const int depth) {
+	this->divide.clear();
+	this->tasks.clear();
+	this->nextTask = 0;
+	if (depth <= 0) return 1;
+
+	split(depth);
+	for (uint id = 1; id < this->threads; id++) Threads[id].run([this, depth]() { this->work(depth); });
+	work(depth);
+	for (uint id = 1; id < this->threads; id++) Threads[id].wait();
+
+	uint64_t nodes = 0;
+	for (const Task& task : this->tasks) this->divide[task.root].nodes += task.nodes;
+	for (const PerftDivide& root : this->divide) nodes += root.nodes;
+	return nodes;
+}
+
+void Perft::split(const int depth) {
+	Position pos = this->pos;
+	const bool splitReplies = this->threads > 1 && depth >= PERFT_SPLIT_DEPTH;
+	for (Move move : MoveList(pos)) {
+		const uint root = this->divide.size();
+		this->divide.push_back({move, 0});
+		if (!splitReplies) {
+			this->tasks.push_back({root, NULL_MOVE});
+			continue;
+		}
+
+		pos.processMakeMove(move);
+		for (Move reply : MoveList(pos)) this->tasks.push_back({root, reply});
+		pos.processUndoMove();
+	}
+}
+
+void Perft::work(const int depth) {
+	Position pos = this->pos;
+	while (true) {
+		const size_t index = this->nextTask.fetch_add(1, std::memory_order_relaxed);
+		if (index >= this->tasks.size()) return;
+
+		Task& task = this->tasks[index];
+		pos.processMakeMove(this->divide[task.root].move);
+		if (task.reply == NULL_MOVE) {
+			task.nodes = perft(pos, depth - 1, this->table);
+		} else {
+			pos.processMakeMove(task.reply);
+			task.nodes = perft(pos, depth - 2, this->table);
+			pos.processUndoMove();
+		}
+		pos.processUndoMove();
+	}
+}
+
+bool parsePerftSuiteLine(const std::string& line, PerftSuiteEntry& entry) {
+	std::vector<std::string> fields = split(line, ";");
+	if (fields.size() < 2) return false;
+
+	entry.fen = concat(split(fields[0], " "), " ");
+	entry.expected.clear();
+	for (size_t index = 1; index < fields.size(); index++) {
+		std::vector<std::string> tokens = split(fields[index], " ");
+		if (tokens.size() != 2 || tokens[0].size() < 2 || tokens[0][0] != 'D') return false;
+		entry.expected.push_back({std::stoi(tokens[0].substr(1)), std::stoull(tokens[1])});
+	}
+	return true;
+}
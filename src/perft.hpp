@@ -0,0 +1,160 @@
+#ifndef PERFT_HPP
+#define PERFT_HPP
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "game.hpp"
+
+/**
+ * Number of leaf nodes under a root move, as reported by the perft divide output.
+ */
+struct PerftDivide {
+	Move move;
+	uint64_t nodes;
+};
+
+const uint PERFT_BUCKET_SIZE = 4;
+
+/**
+ * A cache of subtree leaf counts keyed by (hash, depth), shared by all perft workers. Lockless in the same way as the
+ * transposition table: the key word is the hash XOR'd with the data word, so a torn entry fails verification.
+ */
+class PerftTable {
+	public:
+		/**
+		 * @brief Allocate the table.
+		 *
+		 * @param megabytes Size of the table in megabytes.
+		 */
+		PerftTable(const size_t megabytes);
+
+		/**
+		 * @brief Look up the leaf count of a position.
+		 *
+		 * @param hash Zobrist hash of the position.
+		 * @param depth Depth the leaves were counted to.
+		 * @param nodes Populated with the leaf count if found.
+		 * @return True if the position was found at the depth, else false.
+		 */
+		bool probe(const Hash hash, const int depth, uint64_t& nodes) const;
+
+		/**
+		 * @brief Store the leaf count of a position. Replaces the entry with the same position and depth if there is
+		 * one, else the shallowest entry in the bucket.
+		 *
+		 * @param hash Zobrist hash of the position.
+		 * @param depth Depth the leaves were counted to.
+		 * @param nodes Leaf count.
+		 */
+		void store(const Hash hash, const int depth, const uint64_t nodes);
+
+	private:
+		struct Entry {
+			std::atomic<uint64_t> key;
+			std::atomic<uint64_t> data; // Leaf count in the upper bits, depth in the lowest byte.
+		};
+
+		struct alignas(CACHE_LINE_SIZE) Bucket {
+			Entry entries[PERFT_BUCKET_SIZE];
+		};
+
+		std::unique_ptr<Bucket[]> buckets;
+		size_t bucketCount = 0;
+};
+
+/**
+ * Counts the leaf nodes of the legal move tree of a position to a fixed depth (perft). The tree is split into tasks
+ * (the root moves, or for deep runs the replies to each root move), which the calling thread and the helpers of the
+ * thread pool take from a shared queue as they finish their previous one. The search must not be running. Each worker has its own copy of the position. The divide output is in move
+ * generation order, so it does not depend on the number of threads.
+ */
+class Perft {
+	public:
+		/**
+		 * @brief Initialise the perft.
+		 *
+		 * @param pos Position to count from. Is copied, so is not modified.
+		 * @param table Cache of subtree leaf counts, or nullptr to count every subtree.
+		 */
+		Perft(const Position& pos, PerftTable* table = nullptr);
+
+		/**
+		 * @brief Count the leaf nodes.
+		 *
+		 * @param depth Depth to count to.
+		 * @return Number of leaf nodes.
+		 */
+		uint64_t run(const int depth);
+
+		/**
+		 * @brief Get the leaf node counts of each root move of the last run.
+		 *
+		 * @return Counts in move generation order.
+		 */
+		inline const std::vector<PerftDivide>& getDivide() const {
+			return this->divide;
+		}
+
+	private:
+		/**
+		 * A subtree to be counted by one worker.
+		 */
+		struct Task {
+			uint root;   // Index of the root move in the divide.
+			Move reply;  // Reply to the root move, or NULL_MOVE if the task is the whole root move.
+			uint64_t nodes = 0;
+		};
+
+		const Position pos;
+		const uint threads;
+		PerftTable* const table;
+		std::vector<PerftDivide> divide;
+		std::vector<Task> tasks;
+		std::atomic<size_t> nextTask = 0;
+
+		/**
+		 * @brief Split the tree into tasks.
+		 *
+		 * @param depth Depth of the run.
+		 */
+		void split(const int depth);
+
+		/**
+		 * @brief Count tasks from the queue until it is empty.
+		 *
+		 * @param depth Depth of the run.
+		 */
+		void work(const int depth);
+};
+
+/**
+ * A position of an EPD perft suite with its expected leaf counts.
+ */
+struct PerftSuiteEntry {
+	std::string fen;
+	std::vector<std::pair<int, uint64_t>> expected; // Depth and leaf count, in the order listed.
+};
+
+/**
+ * @brief Parse a line of an EPD perft suite, of the form "<fen> ;D1 <count> ;D2 <count> ...".
+ *
+ * @param line Line to parse.
+ * @param entry Populated with the position and its expected counts.
+ * @return True if the line holds a position with at least one expected count, else false.
+ */
+bool parsePerftSuiteLine(const std::string& line, PerftSuiteEntry& entry);
+
+/**
+ * @brief Count the leaf nodes of a position on the calling thread.
+ *
+ * @param pos Position to count from. Is restored before returning.
+ * @param depth Depth to count to.
+ * @param table Cache of subtree leaf counts, or nullptr to count every subtree.
+ * @return Number of leaf nodes.
+ */
+uint64_t perft(Position& pos, const int depth, PerftTable* table = nullptr);
+
+#endif
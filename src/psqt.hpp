@@ -0,0 +1,202 @@
+#ifndef PSQT_HPP
+#define PSQT_HPP
+
+#include <array>
+
+#include "constants.hpp"
+
+namespace PieceValue {
+	const int PAWN = 100;
+	const int KNIGHT = 300;
+	const int BISHOP = 325;
+	const int ROOK = 500;
+	const int QUEEN = 900;
+}
+
+namespace PSQT::MiddleGame {
+	constexpr int KING[SQUARE_COUNT] = {
+		 20,  30,  10,   0,   0,  10,  30,  20,
+		 20,  20,   0,   0,   0,   0,  20,  20,
+		-10, -20, -20, -20, -20, -20, -20, -10,
+		-20, -30, -30, -40, -40, -30, -30, -20,
+		-30, -40, -40, -50, -50, -40, -40, -30,
+		-30, -40, -40, -50, -50, -40, -40, -30,
+		-30, -40, -40, -50, -50, -40, -40, -30,
+		-30, -40, -40, -50, -50, -40, -40, -30
+	};
+
+	constexpr int QUEEN[SQUARE_COUNT] = {
+		-20, -10, -10, -5, -5, -10, -10, -20,
+		-10,   0,   5,  0,  0,   0,   0, -10,
+		-10,   5,   5,  5,  5,   5,   0, -10,
+		  0,   0,   5,  5,  5,   5,   0,  -5,
+		 -5,   0,   5,  5,  5,   5,   0,  -5,
+		-10,   0,   5,  5,  5,   5,   0, -10,
+		-10,   0,   0,  0,  0,   0,   0, -10,
+		-20, -10, -10, -5, -5, -10, -10, -20
+	};
+
+	constexpr int ROOK[SQUARE_COUNT] = {
+		 0,  0,  0,  5,  5,  0,  0,  0,
+		-5,  0,  0,  0,  0,  0,  0, -5,
+		-5,  0,  0,  0,  0,  0,  0, -5,
+		-5,  0,  0,  0,  0,  0,  0, -5,
+		-5,  0,  0,  0,  0,  0,  0, -5,
+		-5,  0,  0,  0,  0,  0,  0, -5,
+		 5, 10, 10, 10, 10, 10, 10,  5,
+		 0,  0,  0,  0,  0,  0,  0,  0
+	};
+
+	constexpr int BISHOP[SQUARE_COUNT] = {
+		-20, -10, -10, -10, -10, -10, -10, -20,
+		-10,   5,   0,   0,   0,   0,   5, -10,
+		-10,  10,  10,  10,  10,  10,  10, -10,
+		-10,   0,  10,  10,  10,  10,   0, -10,
+		-10,   5,   5,  10,  10,   5,   5, -10,
+		-10,   0,   5,  10,  10,   5,   0, -10,
+		-10,   0,   0,   0,   0,   0,   0, -10,
+		-20, -10, -10, -10, -10, -10, -10, -20
+	};
+
+	constexpr int KNIGHT[SQUARE_COUNT] = {
+		-50, -40, -30, -30, -30, -30, -40, -50,
+		-40, -20,   0,   5,   5,   0, -20, -40,
+		-30,   5,  10,  15,  15,  10,   5, -30,
+		-30,   0,  15,  20,  20,  15,   0, -30,
+		-30,   5,  15,  20,  20,  15,   5, -30,
+		-30,   0,  10,  15,  15,  10,   0, -30,
+		-40, -20,   0,   0,   0,   0, -20, -40,
+		-50, -40, -30, -30, -30, -30, -40, -50
+	};
+
+	constexpr int PAWN[SQUARE_COUNT] = {
+		 0,  0,   0,   0,   0,   0,  0,  0,
+		 5, 10,  10, -20, -20,  10, 10,  5,
+		 5, -5, -10,   0,   0, -10, -5,  5,
+		 0,  0,   0,  20,  20,   0,  0,  0,
+		 5,  5,  10,  25,  25,  10,  5,  5,
+		10, 10,  20,  30,  30,  20, 10, 10,
+		50, 50,  50,  50,  50,  50, 50, 50,
+		 0,  0,   0,   0,   0,   0,  0,  0
+	};
+}
+
+namespace PSQT::EndGame {
+	constexpr int KING[SQUARE_COUNT] = {
+		-10, -20, -20, -20, -20, -20, -20, -10,
+		  0,   0,   0,   0,   0,   0,   0,   0,
+		 10,  10,  10,  10,  10,  10,  10,  10,
+		 20,  20,  15,  15,  15,  15,  20,  20,
+		 20,  20,  25,  25,  25,  25,  20,  20,
+		 20,  20,  25,  25,  25,  25,  20,  20,
+		 20,  20,  25,  25,  25,  25,  20,  20,
+		 20,  30,  30,  30,  30,  30,  30,  20
+	};
+
+	constexpr int QUEEN[SQUARE_COUNT] = {
+		-20, -10, -10, -5, -5, -10, -10, -20,
+		-10,   0,   5,  0,  0,   0,   0, -10,
+		-10,   5,   5,  5,  5,   5,   0, -10,
+		  0,   0,   5,  5,  5,   5,   0,  -5,
+		 -5,   0,   5,  5,  5,   5,   0,  -5,
+		-10,   0,   5,  5,  5,   5,   0, -10,
+		-10,   0,   0,  0,  0,   0,   0, -10,
+		-20, -10, -10, -5, -5, -10, -10, -20
+	};
+
+	constexpr int ROOK[SQUARE_COUNT] = {
+		 0,  0,  0,  5,  5,  0,  0,  0,
+		-5,  0,  0,  0,  0,  0,  0, -5,
+		-5,  0,  0,  0,  0,  0,  0, -5,
+		-5,  0,  0,  0,  0,  0,  0, -5,
+		-5,  0,  0,  0,  0,  0,  0, -5,
+		-5,  0,  0,  0,  0,  0,  0, -5,
+		 5, 10, 10, 10, 10, 10, 10,  5,
+		 0,  0,  0,  0,  0,  0,  0,  0
+	};
+
+	constexpr int BISHOP[SQUARE_COUNT] = {
+		-20, -10, -10, -10, -10, -10, -10, -20,
+		-10,   5,   0,   0,   0,   0,   5, -10,
+		-10,  10,  10,  10,  10,  10,  10, -10,
+		-10,   0,  10,  10,  10,  10,   0, -10,
+		-10,   5,   5,  10,  10,   5,   5, -10,
+		-10,   0,   5,  10,  10,   5,   0, -10,
+		-10,   0,   0,   0,   0,   0,   0, -10,
+		-20, -10, -10, -10, -10, -10, -10, -20
+	};
+
+	constexpr int KNIGHT[SQUARE_COUNT] = {
+		-50, -40, -30, -30, -30, -30, -40, -50,
+		-40, -20,   0,   5,   5,   0, -20, -40,
+		-30,   5,  10,  15,  15,  10,   5, -30,
+		-30,   0,  15,  20,  20,  15,   0, -30,
+		-30,   5,  15,  20,  20,  15,   5, -30,
+		-30,   0,  10,  15,  15,  10,   0, -30,
+		-40, -20,   0,   0,   0,   0, -20, -40,
+		-50, -40, -30, -30, -30, -30, -40, -50
+	};
+
+	constexpr int PAWN[SQUARE_COUNT] = {
+		 0,   0,   0,   0,   0,   0,   0,  0,
+		-5, -10, -10, -20, -20,  10, -10, -5,
+		-5,  -5, -10, -10, -10, -10,  -5, -5,
+		 0,   0,   0,  20,  20,   0,   0,  0,
+		 5,   5,  10,  25,  25,  10,   5,  5,
+		10,  10,  20,  30,  30,  20,  10, 10,
+		50,  50,  50,  50,  50,  50,  50, 50,
+		 0,   0,   0,   0,   0,   0,   0,  0
+	};
+}
+
+namespace PSQT {
+	typedef std::array<std::array<int, SQUARE_COUNT>, PIECE_TYPE_COUNT> PieceSquareTable;
+
+	/**
+	 * @brief Build the piece square values of every piece type from the tables of one game stage, from white's
+	 * perspective. Black pieces take the negated value of the vertically mirrored square.
+	 *
+	 * @param tables Tables of the stage, indexed by BasePieceType.
+	 * @return Piece square values indexed as [PieceType][Square].
+	 */
+	constexpr PieceSquareTable buildPieceSquareTable(const std::array<const int*, BASE_PIECE_TYPE_COUNT> tables) {
+		const PieceType white[BASE_PIECE_TYPE_COUNT] = {W_KING, W_QUEEN, W_ROOK, W_BISHOP, W_KNIGHT, W_PAWN};
+		const PieceType black[BASE_PIECE_TYPE_COUNT] = {B_KING, B_QUEEN, B_ROOK, B_BISHOP, B_KNIGHT, B_PAWN};
+		PieceSquareTable table = {};
+		for (uint piece = 0; piece < BASE_PIECE_TYPE_COUNT; piece++) {
+			for (uint square = 0; square < SQUARE_COUNT; square++) {
+				table[white[piece]][square] = tables[piece][square];
+				table[black[piece]][square] = -tables[piece][square ^ 56]; // Same as mirror(square).
+			}
+		}
+		return table;
+	}
+
+	constexpr PieceSquareTable MIDDLEGAME_VALUES = buildPieceSquareTable({ MiddleGame::KING, MiddleGame::QUEEN,
+			MiddleGame::ROOK, MiddleGame::BISHOP, MiddleGame::KNIGHT, MiddleGame::PAWN });
+	constexpr PieceSquareTable ENDGAME_VALUES = buildPieceSquareTable({ EndGame::KING, EndGame::QUEEN, EndGame::ROOK,
+			EndGame::BISHOP, EndGame::KNIGHT, EndGame::PAWN });
+
+	/**
+	 * Material value of every piece type in centipawns from white's perspective. Kings are never captured, so they
+	 * have no value.
+	 */
+	constexpr std::array<int, PIECE_TYPE_COUNT> MATERIAL_VALUES = {
+		0, 0,
+		PieceValue::QUEEN, PieceValue::ROOK, PieceValue::BISHOP, PieceValue::KNIGHT, PieceValue::PAWN,
+		-PieceValue::QUEEN, -PieceValue::ROOK, -PieceValue::BISHOP, -PieceValue::KNIGHT, -PieceValue::PAWN
+	};
+
+	/**
+	 * Weight of every piece type in the game phase, which is the sum of the weights of the pieces on the board. The
+	 * phase is MAX_PHASE in the starting position and 0 once only kings and pawns are left.
+	 */
+	const int MAX_PHASE = 24;
+	constexpr std::array<int, PIECE_TYPE_COUNT> PHASE_WEIGHTS = {
+		0, 0,
+		4, 2, 1, 1, 0,
+		4, 2, 1, 1, 0
+	};
+}
+
+#endif
@@ -1,23 +1,21 @@
 #include "search.hpp"
 #include "sicario.hpp"
 #include "mcts.hpp"
+#include "minimax.hpp"
 
 #include <iostream>
 #include "evaluate.hpp"
+#include "transposition.hpp"
 
-void Sicario::search() {
-	Mcts searcher(this->getPosition(), this->searchTree, this->sicarioConfigs);
-	searcher.search();
+void Sicario::search(const Position& root) {
+	TT.newSearch();
+	static_assert(Searcher<Mcts>);
+	static_assert(Searcher<MiniMax>);
+	if (this->sicarioConfigs.options[SEARCH_ALGORITHM].value == "alphabeta") {
+		MiniMax searcher(root, Threads[0].getState(), this->searchTree, this->timeManager, this->sicarioConfigs);
+		searcher.run();
+	} else {
+		Mcts searcher(root, Threads[0].getState(), this->searchTree, this->timeManager, this->sicarioConfigs);
+		searcher.run();
+	}
 }
-
-Position& BaseSearcher::getPos() {
-	return this->pos;
-}
-
-Move BaseNode::getInEdge() const {
-	return this->inEdge;
-}
-
-Position& BaseNode::getPos() {
-	return this->pos;
-}
\ No newline at end of file
@@ -3,48 +3,142 @@
 
 #include <vector>
 #include <memory>
+#include <concepts>
+#include <span>
+#include <thread>
 
 #include "sicario.hpp"
+#include "arena.hpp"
+#include "timemanager.hpp"
+#include "threadpool.hpp"
 
 struct SearchInfo {
 	int depth = 0;
+	uint hashfull = 0;
 
 	bool operator!=(const SearchInfo& s) {
-		return this->depth != s.depth;
+		return this->depth != s.depth || this->hashfull != s.hashfull;
 	}
 };
 
+/**
+ * Base of the tree searchers. Searchers derive from this with themselves as the template argument (CRTP) rather than
+ * overriding virtual functions, so calls within a search are resolved at compile time. A searcher works in the
+ * SearchState of the thread that runs it, which outlives the searcher.
+ */
+template<typename Derived>
 class BaseSearcher {
 	public:
-		BaseSearcher(const Position& pos, const std::atomic_bool& searchTree, const SicarioConfigs& sicarioConfigs) :
-				pos(pos), rootPlayer(pos.getTurn()), searchTree(searchTree), sicarioConfigs(sicarioConfigs) {}
-		virtual void search() = 0;
-		Position& getPos();
+		/**
+		 * @param root Position to search. Copied into the position of the state.
+		 * @param state Search state of the thread that runs the search.
+		 */
+		BaseSearcher(const Position& root, SearchState& state, std::atomic_bool& searchTree,
+				const TimeManager& timeManager, const SicarioConfigs& sicarioConfigs) : pos(state.pos), state(state),
+				rootPlayer(root.getTurn()), searchTree(searchTree), timeManager(timeManager),
+				sicarioConfigs(sicarioConfigs) {
+			this->pos = root;
+			this->pos.setSearchRoot(sicarioConfigs.options[TWO_FOLD_REPETITION].value == "true");
+		}
+
+		inline Position& getPos() {
+			return this->pos;
+		}
+
+		/**
+		 * @brief Search the root position, then send the best move found once the search is finished.
+		 *
+		 * @param report Whether to send info and the best move to the GUI. Off for searches the GUI did not ask for,
+		 * such as those of the bench command.
+		 */
+		void run(const bool report = true) {
+			this->report = report;
+			derived().search();
+			finish();
+			if (report) derived().sendBestMove();
+		}
 
 	protected:
-		Position pos;
+		Position& pos;
+		SearchState& state;
 		const Player rootPlayer;
-		const std::atomic_bool& searchTree;
+		std::atomic_bool& searchTree;
+		const TimeManager& timeManager;
 		const SicarioConfigs& sicarioConfigs;
+		bool report = true;
+
+	private:
+		inline Derived& derived() {
+			return static_cast<Derived&>(*this);
+		}
+
+		/**
+		 * @brief Mark the search as finished. Must be called before sending the best move, as the GUI may start the
+		 * next search as soon as it reads it. An infinite or ponder search that ends by itself first waits for the
+		 * GUI to stop it (or for a ponderhit), as the best move may not be sent before then.
+		 */
+		inline void finish() {
+			while (this->searchTree && this->timeManager.isOpenEnded())
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			this->searchTree = false;
+		}
+};
+
+/**
+ * A searcher that can be run by Sicario::search. It searches until stopped or a limit is reached, keeping what it needs
+ * to send the best move afterwards.
+ */
+template<typename T>
+concept Searcher = std::derived_from<T, BaseSearcher<T>> && requires(T searcher) {
+	searcher.search();
+	searcher.sendBestMove();
 };
 
+/**
+ * Node of a search tree stored in a NodeArena. The parent and children are referred to by arena index, with all of a
+ * node's children allocated as one contiguous block. Node types derive from this with themselves as the template
+ * argument (CRTP) and provide a static arena() returning the arena they are stored in, so walking the tree needs no
+ * virtual calls or casts.
+ */
+template<typename Node>
 class BaseNode {
 	public:
-		BaseNode(BaseNode* parent, Position& pos, SearchInfo& searchInfo) :
-				parent(parent), searchInfo(searchInfo), pos(pos), rootPlayer(pos.getTurn()) {} // CHECK learn about initialiser list
-		Move getInEdge() const;
-		Position& getPos();
+		BaseNode() = default;
+		BaseNode(NodeIndex parent, Move inEdge, int depth) : depth(depth), parent(parent), inEdge(inEdge) {}
+
+		inline Move getInEdge() const {
+			return this->inEdge;
+		}
+
+		inline int getDepth() const {
+			return this->depth;
+		}
+
+		/**
+		 * @brief Get the parent of the node.
+		 *
+		 * @return Pointer to the parent, or nullptr if this is a root.
+		 */
+		inline Node* getParent() const {
+			return this->parent == NULL_NODE ? nullptr : &Node::arena()[this->parent];
+		}
 
 	protected:
-		int depth;
-		Move inEdge;
-		BaseNode* parent;
-		SearchInfo& searchInfo;
-		std::vector<std::unique_ptr<BaseNode>> children; // CHECK unique? or shared?
-		Position& pos;
-		const Player rootPlayer;
+		int depth = 0;
+		NodeIndex parent = NULL_NODE;
+		NodeIndex firstChild = NULL_NODE;
+		Move inEdge = NULL_MOVE;
+		uint8_t childCount = 0;
 
-		virtual void addChild(Move move) = 0;
+		/**
+		 * @brief Get the children of the node. Only valid once the children have been published by the derived node.
+		 *
+		 * @return Span over the block of children.
+		 */
+		inline std::span<Node> children() const {
+			if (this->childCount == 0) return {};
+			return std::span<Node>(&Node::arena()[this->firstChild], this->childCount);
+		}
 };
 
-#endif
\ No newline at end of file
+#endif
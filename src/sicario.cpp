@@ -1,9 +1,13 @@
 
+#include <algorithm>
 #include <iostream>
 #include "sicario.hpp"
 #include "uci.hpp"
 #include "constants.hpp"
 #include "utils.hpp"
+#include "transposition.hpp"
+#include "mcts.hpp"
+#include "threadpool.hpp"
 
 void showInfo(int argc, char* argv[]) {
 	if (argc < 2) return;
@@ -49,7 +53,12 @@ Sicario::Sicario() {
 	sicarioConfigs.options[UCI_ELO] = { "UCI_Elo", "spin", "3000", "1000", "3500" };
 	sicarioConfigs.options[UCI_ANALYSE_MODE] = { "UCI_AnalyseMode", "check", "true" };
 	sicarioConfigs.options[UCI_OPPONENT] = { "UCI_Opponent", "string", "" };
-	sicarioConfigs.options[EXPAND_TIME] = { "ExpandTime", "spin", "50", "1", "500" };
+	sicarioConfigs.options[EXPAND_TIME] = { "ExpandTime", "spin", "100", "1", "500" };
+	sicarioConfigs.options[MCTS_PARALLEL] = { "MctsParallel", "combo", "tree", "", "", { "tree", "root" } };
+	sicarioConfigs.options[ROLLOUT_PLIES] = { "RolloutPlies", "spin", "0", "0", "1000" };
+	sicarioConfigs.options[TWO_FOLD_REPETITION] = { "TwoFoldRepetition", "check", "false" };
+	sicarioConfigs.options[SEARCH_ALGORITHM] = { "Search", "combo", "mcts", "", "", { "mcts", "alphabeta" } };
+	sicarioConfigs.options[EVAL_FILE] = { "EvalFile", "string", "" };
 	sicarioConfigs.options[CLEAR_HASH] = { "ClearHash", "button" };
 
 	// Set the configs to the default
@@ -60,6 +69,23 @@ Sicario::Sicario() {
 	for (int index = THREAD; index < CONFIGS_COUNT; index++)
 		assert(sicarioConfigs.options[index].name != "");
 	#endif
+
+	Threads.resize(std::stoi(sicarioConfigs.options[THREAD].value));
+
+	resizeHash(std::stoi(sicarioConfigs.options[HASH].value));
+}
+
+void Sicario::resizeHash(const size_t megabytes) {
+	// Alpha-beta does not use the arena, which is left at its minimum size.
+	const bool alphaBeta = sicarioConfigs.options[SEARCH_ALGORITHM].value == "alphabeta";
+	const size_t ttMegabytes = std::max<size_t>(alphaBeta ? megabytes : megabytes / TT_HASH_DIVISOR, 1);
+	TT.resize(ttMegabytes);
+	MctsArena.resize((megabytes - std::min(ttMegabytes, megabytes)) * 1024 * 1024);
+}
+
+void Sicario::stopSearch() {
+	this->searchTree = false;
+	Threads[0].wait();
 }
 
 void Sicario::run() {
@@ -71,27 +97,3 @@ void Sicario::run() {
 
 	this->searchTree = false;
 }
-
-uint64_t Sicario::perft(const int depth, const bool root) {
-	uint64_t nodes = 0;
-	uint64_t current_node_count = 0;
-
-	for (Move move: MoveList(this->position)) {
-		if (depth <= 1) {
-			current_node_count = 1;
-			nodes++;
-		} else {
-			this->position.processMakeMove(move, false);
-			current_node_count = depth == 2 ? MoveList(this->position).size() : perft(depth - 1);
-			this->position.processUndoMove();
-			nodes += current_node_count;
-		}
-
-		if (root) {
-			printMove(move, false);
-			std::cout << ": " << current_node_count << '\n';
-		}
-	}
-
-	return nodes;
-}
\ No newline at end of file
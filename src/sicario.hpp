@@ -3,9 +3,9 @@
 #define SICARIO_HPP
 
 #include <atomic>
-#include <thread>
 #include "constants.hpp"
 #include "game.hpp"
+#include "timemanager.hpp"
 
 struct OptionInfo {
 	std::string name = "";
@@ -49,18 +49,41 @@ class Sicario {
 		 */
 		void run();
 
+		/**
+		 * Parses the GUI input string and calls handlers for commands.
+		 *
+		 * @param input Input string from GUI.
+		 */
+		void processInput(const std::string& input);
+
+		/**
+		 * @brief Get a reference to the Position object.
+		 *
+		 * @return A reference to the position object.
+		 */
+		inline Position& getPosition() {
+			return this->position;
+		}
+
 	private:
 		Position position;
 		SicarioConfigs sicarioConfigs;
-		std::vector<std::thread> threads;
+
+		// Start and moves of the last position command, which the position currently holds. An empty start means that
+		// the position has been changed since, so the next position command replays the whole game.
+		std::string positionStart;
+		std::vector<std::string> positionMoves;
 		std::atomic_bool searchTree = false;
+		TimeManager timeManager;
 
 		/**
-		 * Parses the GUI input string and calls handlers for commands.
+		 * @brief Split the Hash budget between the transposition table and the MCTS node arena, discarding the contents
+		 * of both. Under MCTS, the table gets 1 / TT_HASH_DIVISOR of the budget and the arena the rest. Under
+		 * alpha-beta, the table gets all of it. The table always gets at least a megabyte.
 		 *
-		 * @param input Input string from GUI.
+		 * @param megabytes Hash budget in megabytes.
 		 */
-		void processInput(const std::string& input);
+		void resizeHash(const size_t megabytes);
 
 		/**
 		 * @brief Hash the input string to the GUI.
@@ -107,14 +130,17 @@ class Sicario {
 		void handleUciNewGame();
 
 		/**
-		 * @brief Handle the position command.
+		 * @brief Handle the position command. Only the moves that differ from the last position command are undone and
+		 * made, so following a game costs a move per command rather than the whole game.
 		 *
 		 * @param inputs Entire input given to the GUI.
 		 */
 		void handlePosition(const std::vector<std::string>& inputs);
 
 		/**
-		 * @brief Handle the go command.
+		 * @brief Handle the go command. Starts a search of the current position, limited by the clock, movetime,
+		 * nodes and depth arguments. The search runs until stopped if it is given none of them, or infinite. A ponder
+		 * search ignores its limits until ponderhit.
 		 *
 		 * @param inputs Entire input given to the GUI.
 		 */
@@ -126,7 +152,8 @@ class Sicario {
 		void handleStop();
 
 		/**
-		 * @brief Handle the ponderhit command.
+		 * @brief Handle the ponderhit command. The opponent played the expected move, so the ponder search carries on
+		 * as a normal search under the limits given with it.
 		 */
 		void handlePonderHit();
 
@@ -140,6 +167,16 @@ class Sicario {
 		 */
 		void handlePerft(const std::vector<std::string>&);
 
+		/**
+		 * @brief Handle the perftsuite command. Runs perft on every position of an EPD file, where each line is a FEN
+		 * followed by the expected counts as ";D<depth> <count>", and reports the result and speed of each position
+		 * and of the whole suite.
+		 *
+		 * @param commands Entire input given to the GUI. The second token is the file, optionally followed by the
+		 * maximum depth to run and "hash <megabytes>" for a node count cache shared by the whole suite.
+		 */
+		void handlePerftSuite(const std::vector<std::string>& commands);
+
 		/**
 		 * @brief Handle the move command. Used for debugging.
 		 */
@@ -180,6 +217,15 @@ class Sicario {
 		 */
 		void handleOptions();
 
+		/**
+		 * @brief Handle the bench command. Runs MCTS on a fixed set of positions for a fixed time each and reports the
+		 * playout rate. Used for benchmarking.
+		 *
+		 * @param commands Entire input given to the GUI. The optional second token is the time per position in
+		 * milliseconds.
+		 */
+		void handleBench(const std::vector<std::string>& commands);
+
 		/**
 		 * @brief Send the invalid command message.
 		 *
@@ -311,6 +357,41 @@ class Sicario {
 		 */
 		void setOptionExpandTime(const std::vector<std::string>& inputs);
 
+		/**
+		 * @brief Set the mctsParallel option.
+		 *
+		 * @param inputs Entire input given to the GUI.
+		 */
+		void setOptionMctsParallel(const std::vector<std::string>& inputs);
+
+		/**
+		 * @brief Set the rolloutPlies option.
+		 *
+		 * @param inputs Entire input given to the GUI.
+		 */
+		void setOptionRolloutPlies(const std::vector<std::string>& inputs);
+
+		/**
+		 * @brief Set the twoFoldRepetition option.
+		 *
+		 * @param inputs Entire input given to the GUI.
+		 */
+		void setOptionTwoFoldRepetition(const std::vector<std::string>& inputs);
+
+		/**
+		 * @brief Set the search option.
+		 *
+		 * @param inputs Entire input given to the GUI.
+		 */
+		void setOptionSearch(const std::vector<std::string>& inputs);
+
+		/**
+		 * @brief Set the evalFile option, loading the network. An empty value unloads it.
+		 *
+		 * @param inputs Entire input given to the GUI.
+		 */
+		void setOptionEvalFile(const std::vector<std::string>& inputs);
+
 		/**
 		 * @brief Get the option name from the setOption command.
 		 *
@@ -326,27 +407,19 @@ class Sicario {
 		std::string getOptionValue(const std::vector<std::string>&);
 
 		/**
-		 * @brief Begins search.
-		 */
-		void search();
-
-		/**
-		 * @brief Begin the perft calculation.
+		 * @brief Begins search. The searcher marks the search as finished just before it sends its best move, whether
+		 * it was stopped or reached a limit.
 		 *
-		 * @param depth Depth to calculate to.
-		 * @param root True, if we are at the root of the perft call. Defauled to false.
-		 * @return Number of positions at the specified depth.
+		 * @param root Position to search. A copy taken by the go command, so that later commands can change the
+		 * position while the search runs.
 		 */
-		uint64_t perft(const int depth, const bool root = false);
+		void search(const Position& root);
 
 		/**
-		 * @brief Get a reference to the Position object.
-		 *
-		 * @return A reference to the position object.
+		 * @brief Stop the search, if one is running, and wait for it to send its best move. Called before changing
+		 * state that the search reads, such as the transposition table, the MCTS arena, the network or the threads.
 		 */
-		inline Position& getPosition() {
-			return this->position;
-		}
+		void stopSearch();
 };
 
 #endif
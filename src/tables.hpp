@@ -0,0 +1,130 @@
+#ifndef TABLES_HPP
+#define TABLES_HPP
+
+#include <array>
+#include <span>
+
+#include "constants.hpp"
+
+/**
+ * Location of a set of values in the flat array of a SetTable.
+ */
+struct TableSpan {
+	uint32_t offset; // Index of the first value of the set.
+	uint32_t length; // Number of values in the set.
+};
+
+/**
+ * A precomputed table with a run of values per square, stored in one flat array. Indexed as table[square][index].
+ *
+ * @tparam T Type of the values.
+ */
+template<typename T>
+class SquareTable {
+	public:
+		/**
+		 * @brief Construct a view of the values. Does not copy them.
+		 *
+		 * @param rows Pointer to the first value of each square.
+		 */
+		constexpr SquareTable(const std::array<const T*, SQUARE_COUNT> rows) : rows(rows) {}
+
+		inline const T* operator[](const Square square) const {
+			return this->rows[square];
+		}
+
+	private:
+		std::array<const T*, SQUARE_COUNT> rows;
+};
+
+/**
+ * A precomputed table of variable length sets of values per square. The values of every set are stored in one flat
+ * array, and the (offset, length) span of every set in another. Indexed as table[square][index], giving a span over the
+ * values of the set.
+ *
+ * @tparam T Type of the values.
+ */
+template<typename T>
+class SetTable {
+	public:
+		/**
+		 * The sets of a single square.
+		 */
+		struct Row {
+			const T* values;
+			const TableSpan* spans;
+
+			inline std::span<const T> operator[](const uint index) const {
+				const TableSpan span = this->spans[index];
+				return std::span<const T>(this->values + span.offset, span.length);
+			}
+		};
+
+		/**
+		 * @brief Construct a view of the sets. Does not copy them.
+		 *
+		 * @param values Flat array of the values of every set.
+		 * @param rows Pointer to the span of the first set of each square.
+		 */
+		constexpr SetTable(const T* values, const std::array<const TableSpan*, SQUARE_COUNT> rows) : values(values),
+				rows(rows) {}
+
+		inline Row operator[](const Square square) const {
+			return {this->values, this->rows[square]};
+		}
+
+	private:
+		const T* values;
+		std::array<const TableSpan*, SQUARE_COUNT> rows;
+};
+
+typedef SetTable<Move> MoveTable;
+
+/*
+ * The tables below are generated at build time by tables/generate_tables, which writes them to src/tables.cpp as
+ * constant data. They need no initialisation at startup and live in the read only part of the binary, so every engine
+ * process on a machine shares the same physical copy.
+ */
+
+namespace Moves {
+	extern const MoveTable KING;
+	extern const MoveTable ROOK;
+	extern const MoveTable BISHOP;
+	extern const MoveTable KNIGHT;
+	extern const std::array<MoveTable, PLAYER_COUNT> PAWN;
+	extern const std::array<std::array<Move, 1>, CASTLING_OPTIONS> CASTLING;
+	extern const std::array<std::array<std::array<std::array<Move, 1>, 2>, FILE_COUNT>, PLAYER_COUNT> EN_PASSANT;
+}
+
+namespace Moves::Blocks {
+	extern const MoveTable ROOK;
+	extern const MoveTable BISHOP;
+}
+
+namespace Indices {
+	extern const SquareTable<uint> ROOK;
+	extern const SquareTable<uint> BISHOP;
+}
+
+namespace Reach {
+	extern const SquareTable<Bitboard> ROOK;
+	extern const SquareTable<Bitboard> BISHOP;
+}
+
+namespace KingReach {
+	extern const SetTable<Square> SQUARES;
+}
+
+namespace Rays {
+	extern const SquareTable<Bitboard> LEVEL;
+	extern const SquareTable<Bitboard> DIAGONAL;
+}
+
+namespace Hashes {
+	extern const std::array<std::array<Hash, SQUARE_COUNT>, PIECE_TYPE_COUNT> PIECES;
+	extern const Hash TURN;
+	extern const std::array<Hash, CASTLING_COMBOS> CASTLING;
+	extern const std::array<Hash, FILE_COUNT> EN_PASSANT;
+}
+
+#endif
@@ -0,0 +1,69 @@
+#include <algorithm>
+
+#include "threadpool.hpp"
+
+ThreadPool Threads;
+
+void SearchState::ageHistory() {
+	for (auto& side : this->history)
+		for (auto& from : side)
+			for (int& value : from) value /= 2;
+}
+
+void SearchState::clear() {
+	std::fill(&this->killers[0][0], &this->killers[0][0] + (MAX_PLY + 1) * KILLER_COUNT, NULL_MOVE);
+	std::fill(&this->history[0][0][0], &this->history[0][0][0] + PLAYER_COUNT * SQUARE_COUNT * SQUARE_COUNT, 0);
+}
+
+SearchThread::SearchThread() : thread(&SearchThread::idle, this) {}
+
+SearchThread::~SearchThread() {
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->exiting = true;
+	}
+	this->condition.notify_all();
+	this->thread.join();
+}
+
+void SearchThread::run(std::function<void()> job) {
+	std::unique_lock<std::mutex> lock(this->mutex);
+	this->condition.wait(lock, [this]() { return !this->busy; });
+	this->job = std::move(job);
+	this->busy = true;
+	lock.unlock();
+	this->condition.notify_all();
+}
+
+void SearchThread::wait() {
+	std::unique_lock<std::mutex> lock(this->mutex);
+	this->condition.wait(lock, [this]() { return !this->busy; });
+}
+
+void SearchThread::idle() {
+	std::unique_lock<std::mutex> lock(this->mutex);
+	while (true) {
+		this->condition.wait(lock, [this]() { return this->busy || this->exiting; });
+		if (!this->busy) return;
+
+		lock.unlock();
+		this->job();
+		lock.lock();
+
+		this->job = nullptr;
+		this->busy = false;
+		this->condition.notify_all();
+	}
+}
+
+void ThreadPool::resize(const uint count) {
+	const uint threadCount = std::max(1U, count);
+	if (threadCount == size()) return;
+
+	this->threads.clear();
+	while (size() < threadCount) this->threads.push_back(std::make_unique<SearchThread>());
+}
+
+void ThreadPool::clearStates() {
+	for (const std::unique_ptr<SearchThread>& thread : this->threads) thread->getState().clear();
+}
@@ -0,0 +1,124 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "constants.hpp"
+#include "game.hpp"
+#include "movepicker.hpp"
+
+/**
+ * Search state that a thread keeps from one search to the next: the position it searches, its node counter and the
+ * move ordering tables of the alpha-beta search. The position is copied into storage that is already allocated, and
+ * the killers and history carry over to the next search, only being cleared by ucinewgame.
+ */
+struct SearchState {
+	Position pos;
+	uint64_t nodes = 0;
+
+	// Killers are the latest quiet moves to cause a cut-off at each ply.
+	Move killers[MAX_PLY + 1][KILLER_COUNT] = {};
+	ButterflyHistory history = {};
+
+	/**
+	 * @brief Halve the history, so that recent cut-offs outweigh older ones.
+	 */
+	void ageHistory();
+
+	/**
+	 * @brief Forget the killers and history, as at the start of a new game.
+	 */
+	void clear();
+};
+
+/**
+ * A thread that lives for as long as the engine (or until the Thread option changes) and runs one job at a time. It
+ * sleeps on a condition variable between jobs, so starting a search costs a wake up rather than creating a thread.
+ */
+class SearchThread {
+	public:
+		SearchThread();
+
+		/**
+		 * @brief Finish the current job, if any, then end the thread.
+		 */
+		~SearchThread();
+
+		SearchThread(const SearchThread&) = delete;
+		SearchThread& operator=(const SearchThread&) = delete;
+
+		/**
+		 * @brief Run a job on the thread. Waits for the previous job to finish first.
+		 *
+		 * @param job Job to run.
+		 */
+		void run(std::function<void()> job);
+
+		/**
+		 * @brief Wait for the current job, if any, to finish.
+		 */
+		void wait();
+
+		/**
+		 * @brief Get the search state of the thread. Only its own jobs may use it, or others while it is idle.
+		 *
+		 * @return Reference to the search state.
+		 */
+		inline SearchState& getState() {
+			return this->state;
+		}
+
+	private:
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::function<void()> job;
+		bool busy = false;
+		bool exiting = false;
+		SearchState state;
+		std::thread thread; // Declared last so the thread starts once the rest of the object is initialised.
+
+		/**
+		 * @brief Body of the thread. Sleeps until it is given a job or told to exit.
+		 */
+		void idle();
+};
+
+/**
+ * The search threads, sized by the Thread option. The first thread runs the search started by the go command, and the
+ * others are helpers that a parallel search hands work to.
+ */
+class ThreadPool {
+	public:
+		/**
+		 * @brief Set the number of threads. Existing threads are kept if the number is unchanged, else they finish
+		 * their jobs and are replaced by threads with a new search state.
+		 *
+		 * @param count Number of threads. At least one is always kept.
+		 */
+		void resize(const uint count);
+
+		/**
+		 * @brief Clear the search state of every thread. The threads must be idle.
+		 */
+		void clearStates();
+
+		inline uint size() const {
+			return this->threads.size();
+		}
+
+		inline SearchThread& operator[](const uint id) const {
+			return *this->threads[id];
+		}
+
+	private:
+		std::vector<std::unique_ptr<SearchThread>> threads;
+};
+
+extern ThreadPool Threads;
+
+#endif
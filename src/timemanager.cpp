@@ -0,0 +1,30 @@
+#include <algorithm>
+
+#include "timemanager.hpp"
+
+void TimeManager::start(const SearchLimits& limits, const Player turn, const uint expandTime,
+		const SearchClock::time_point now) {
+	this->startTime = now;
+	this->pondering = limits.ponder;
+	this->limits = limits;
+	this->timed = !limits.infinite && (limits.moveTime > 0 || limits.clock[turn]);
+	if (!this->timed) return;
+
+	if (limits.moveTime > 0) {
+		this->softLimit = this->hardLimit = limits.moveTime > MOVE_OVERHEAD ? limits.moveTime - MOVE_OVERHEAD : 1;
+		return;
+	}
+
+	const uint64_t remaining = limits.time[turn];
+	const uint64_t available = remaining > MOVE_OVERHEAD ? remaining - MOVE_OVERHEAD : 1;
+	const uint movesToGo = limits.movesToGo > 0 ? std::min(limits.movesToGo, MAX_MOVES_TO_GO) : DEFAULT_MOVES_TO_GO;
+	const uint64_t share = remaining / movesToGo + limits.increment[turn] * 3 / 4;
+	this->softLimit = std::clamp<uint64_t>(share * expandTime / 100, 1, available);
+	this->hardLimit = std::min(this->softLimit * HARD_LIMIT_RATIO, available);
+}
+
+void TimeManager::ponderHit(const SearchClock::time_point now) {
+	// The clock of the player to move only starts now, so the limits are counted from here.
+	this->startTime = now;
+	this->pondering = false;
+}
@@ -0,0 +1,170 @@
+#ifndef TIMEMANAGER_HPP
+#define TIMEMANAGER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "constants.hpp"
+
+const uint64_t MOVE_OVERHEAD = 30;  // Milliseconds kept back from every move for communication with the GUI.
+const uint DEFAULT_MOVES_TO_GO = 30; // Moves the remaining time is split over when the GUI does not say.
+const uint MAX_MOVES_TO_GO = 50;
+const uint64_t HARD_LIMIT_RATIO = 4; // The hard limit is at most this many times the soft limit.
+const uint64_t TIME_CHECK_NODES = 1024; // Nodes between reads of the clock by the alpha-beta search.
+
+typedef std::chrono::steady_clock SearchClock;
+
+/**
+ * Limits of a search, as given by the go command. Times are in milliseconds and zero values are unset, except for the
+ * remaining times, which are set if their clock is.
+ */
+struct SearchLimits {
+	bool clock[PLAYER_COUNT] = {false, false}; // Whether the remaining time of each player was given.
+	uint64_t time[PLAYER_COUNT] = {0, 0};
+	uint64_t increment[PLAYER_COUNT] = {0, 0};
+	uint movesToGo = 0;
+	uint64_t moveTime = 0;
+	uint64_t nodes = 0;
+	int depth = 0;
+	bool infinite = false;
+	bool ponder = false;
+};
+
+/**
+ * Turns the limits of a search into deadlines. Searchers poll it and stop themselves once a limit is reached, so a
+ * search that is given none runs until the stop command.
+ *
+ * Under a clock, the soft limit is the share of the remaining time for one move (plus most of the increment), scaled by
+ * the ExpandTime option as a percentage. A searcher should not start work that it cannot finish once the soft limit has
+ * passed, such as another iteration. The hard limit allows up to HARD_LIMIT_RATIO times as long to finish work already
+ * started. Both are kept MOVE_OVERHEAD short of the remaining time, but are at least a millisecond, so a clock that has
+ * run out moves at once rather than never. A movetime sets both limits to itself.
+ *
+ * A ponder search runs without time limits until the ponderhit command, which starts the clock. Only the pondering
+ * flag and the start time change during a search, so only they are atomic.
+ *
+ * Every method that reads the clock takes the current time, which defaults to now, so that tests can supply their own.
+ */
+class TimeManager {
+	public:
+		/**
+		 * @brief Start the clock of a search and set its deadlines.
+		 *
+		 * @param limits Limits of the search.
+		 * @param turn Player to move, whose clock is used.
+		 * @param expandTime Percentage to scale the time given to the move by.
+		 * @param now Current time.
+		 */
+		void start(const SearchLimits& limits, const Player turn, const uint expandTime,
+				const SearchClock::time_point now = SearchClock::now());
+
+		/**
+		 * @brief Switch a ponder search to the time limits given with it, counted from now.
+		 *
+		 * @param now Current time.
+		 */
+		void ponderHit(const SearchClock::time_point now = SearchClock::now());
+
+		/**
+		 * @brief Get the milliseconds since the search started.
+		 *
+		 * @param now Current time.
+		 * @return Elapsed time in milliseconds.
+		 */
+		inline uint64_t elapsed(const SearchClock::time_point now = SearchClock::now()) const {
+			const auto start = this->startTime.load(std::memory_order_relaxed);
+			return std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count();
+		}
+
+		/**
+		 * @brief Check if the soft limit has passed.
+		 *
+		 * @param now Current time.
+		 * @return True if the searcher should not start more work, else false. Always false without a time limit or
+		 * while pondering.
+		 */
+		inline bool softLimitReached(const SearchClock::time_point now = SearchClock::now()) const {
+			return this->timed && !isPondering() && elapsed(now) >= this->softLimit;
+		}
+
+		/**
+		 * @brief Check if the hard limit has passed.
+		 *
+		 * @param now Current time.
+		 * @return True if the searcher must stop, else false. Always false without a time limit or while pondering.
+		 */
+		inline bool hardLimitReached(const SearchClock::time_point now = SearchClock::now()) const {
+			return this->timed && !isPondering() && elapsed(now) >= this->hardLimit;
+		}
+
+		/**
+		 * @brief Check if a number of nodes (or playouts) reaches the node limit.
+		 *
+		 * @param nodes Nodes searched so far.
+		 * @return True if the searcher must stop, else false. Always false without a node limit.
+		 */
+		inline bool nodeLimitReached(const uint64_t nodes) const {
+			return this->limits.nodes > 0 && nodes >= this->limits.nodes;
+		}
+
+		/**
+		 * @brief Get the depth limit of the search.
+		 *
+		 * @return Maximum depth, or 0 if there is none.
+		 */
+		inline int getDepthLimit() const {
+			return this->limits.depth;
+		}
+
+		/**
+		 * @brief Check if the search has time limits. A ponder search has them from the start, though they only
+		 * apply after the ponderhit.
+		 *
+		 * @return True if the search is timed, else false.
+		 */
+		inline bool isTimed() const {
+			return this->timed;
+		}
+
+		/**
+		 * @brief Get the soft limit of a timed search.
+		 *
+		 * @return Soft limit in milliseconds from the start of the search.
+		 */
+		inline uint64_t getSoftLimit() const {
+			return this->softLimit;
+		}
+
+		/**
+		 * @brief Get the hard limit of a timed search.
+		 *
+		 * @return Hard limit in milliseconds from the start of the search.
+		 */
+		inline uint64_t getHardLimit() const {
+			return this->hardLimit;
+		}
+
+		inline bool isPondering() const {
+			return this->pondering.load(std::memory_order_acquire);
+		}
+
+		/**
+		 * @brief Check if the best move must wait for the GUI, as the search is infinite or pondering.
+		 *
+		 * @return True if the search may only end with the stop (or ponderhit) command, else false.
+		 */
+		inline bool isOpenEnded() const {
+			return this->limits.infinite || isPondering();
+		}
+
+	private:
+		std::atomic<SearchClock::time_point> startTime = SearchClock::now();
+		std::atomic_bool pondering = false;
+		SearchLimits limits;
+		bool timed = false;
+		uint64_t softLimit = 0;
+		uint64_t hardLimit = 0;
+};
+
+#endif
@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "transposition.hpp"
+#include "threadpool.hpp"
+
+TranspositionTable TT;
+
+const uint VALUE_SHIFT = 0;
+const uint MOVE_SHIFT = 32;
+const uint DEPTH_SHIFT = 48;
+const uint BOUND_SHIFT = 56;
+const uint GENERATION_SHIFT = 58;
+const uint64_t BOUND_MASK = 0b11;
+
+/**
+ * @brief Pack the entry contents into a single 64 bit word.
+ *
+ * @return The packed data word.
+ */
+inline uint64_t packData(const Move move, const float value, const int depth, const Bound bound,
+		const uint8_t generation) {
+	uint32_t valueBits;
+	std::memcpy(&valueBits, &value, sizeof(valueBits));
+	return static_cast<uint64_t>(valueBits) << VALUE_SHIFT |
+			static_cast<uint64_t>(move) << MOVE_SHIFT |
+			static_cast<uint64_t>(static_cast<uint8_t>(depth)) << DEPTH_SHIFT |
+			static_cast<uint64_t>(bound) << BOUND_SHIFT |
+			static_cast<uint64_t>(generation & TT_GENERATION_MASK) << GENERATION_SHIFT;
+}
+
+inline Move dataMove(const uint64_t data) {
+	return static_cast<Move>(data >> MOVE_SHIFT);
+}
+
+inline float dataValue(const uint64_t data) {
+	uint32_t valueBits = static_cast<uint32_t>(data >> VALUE_SHIFT);
+	float value;
+	std::memcpy(&value, &valueBits, sizeof(value));
+	return value;
+}
+
+inline int dataDepth(const uint64_t data) {
+	return static_cast<int8_t>(data >> DEPTH_SHIFT);
+}
+
+inline Bound dataBound(const uint64_t data) {
+	return static_cast<Bound>((data >> BOUND_SHIFT) & BOUND_MASK);
+}
+
+inline uint8_t dataGeneration(const uint64_t data) {
+	return static_cast<uint8_t>(data >> GENERATION_SHIFT);
+}
+
+void TranspositionTable::resize(const size_t megabytes) {
+	this->buckets.reset();
+	this->bucketCount = megabytes * 1024 * 1024 / sizeof(Bucket);
+	if (this->bucketCount == 0) return;
+	this->buckets = std::make_unique<Bucket[]>(this->bucketCount);
+	clear();
+}
+
+void TranspositionTable::clear() {
+	// The calling thread zeroes the first slice and the helpers of the pool the rest.
+	const uint threadCount = std::max(1U, Threads.size());
+	auto zero = [this, threadCount](const uint index) {
+		const size_t stride = this->bucketCount / threadCount;
+		const size_t start = index * stride;
+		const size_t end = index == threadCount - 1 ? this->bucketCount : start + stride;
+		for (size_t bucket = start; bucket < end; bucket++) {
+			for (Entry& entry : this->buckets[bucket].entries) {
+				entry.key.store(0, std::memory_order_relaxed);
+				entry.data.store(0, std::memory_order_relaxed);
+			}
+		}
+	};
+	for (uint index = 1; index < threadCount; index++) Threads[index].run([zero, index]() { zero(index); });
+	zero(0);
+	for (uint index = 1; index < threadCount; index++) Threads[index].wait();
+	this->generation = 0;
+}
+
+void TranspositionTable::newSearch() {
+	this->generation = (this->generation + 1) & TT_GENERATION_MASK;
+}
+
+bool TranspositionTable::probe(const Hash hash, TTData& data) const {
+	if (this->bucketCount == 0) return false;
+
+	for (const Entry& entry : getBucket(hash).entries) {
+		uint64_t entryData = entry.data.load(std::memory_order_relaxed);
+		uint64_t entryKey = entry.key.load(std::memory_order_relaxed);
+		if ((entryKey ^ entryData) != hash || entryData == 0) continue;
+
+		data.move = dataMove(entryData);
+		data.value = dataValue(entryData);
+		data.depth = dataDepth(entryData);
+		data.bound = dataBound(entryData);
+		return true;
+	}
+	return false;
+}
+
+void TranspositionTable::store(const Hash hash, Move move, const float value, const int depth, const Bound bound) {
+	if (this->bucketCount == 0) return;
+
+	Bucket& bucket = getBucket(hash);
+	Entry* replace = &bucket.entries[0];
+	int replaceScore = std::numeric_limits<int>::max();
+	for (Entry& entry : bucket.entries) {
+		uint64_t entryData = entry.data.load(std::memory_order_relaxed);
+		uint64_t entryKey = entry.key.load(std::memory_order_relaxed);
+
+		// Same position. Keep the deeper result unless the new one is exact or from a newer search.
+		if ((entryKey ^ entryData) == hash && entryData != 0) {
+			if (bound != BOUND_EXACT && depth < dataDepth(entryData) - 2 &&
+					dataGeneration(entryData) == this->generation)
+				return;
+			if (move == NULL_MOVE) move = dataMove(entryData);
+			replace = &entry;
+			break;
+		}
+
+		// Empty slot.
+		if (entryData == 0) {
+			replace = &entry;
+			break;
+		}
+
+		// Otherwise prefer replacing shallow entries from older searches.
+		int age = (this->generation - dataGeneration(entryData)) & TT_GENERATION_MASK;
+		int score = dataDepth(entryData) - 8 * age;
+		if (score < replaceScore) {
+			replaceScore = score;
+			replace = &entry;
+		}
+	}
+
+	uint64_t data = packData(move, value, depth, bound, this->generation);
+	replace->key.store(hash ^ data, std::memory_order_relaxed);
+	replace->data.store(data, std::memory_order_relaxed);
+}
+
+uint TranspositionTable::hashfull() const {
+	const size_t sample = std::min(this->bucketCount, static_cast<size_t>(1000));
+	if (sample == 0) return 0;
+
+	uint count = 0;
+	for (size_t index = 0; index < sample; index++) {
+		for (const Entry& entry : this->buckets[index].entries) {
+			uint64_t entryData = entry.data.load(std::memory_order_relaxed);
+			if (entryData != 0 && dataGeneration(entryData) == this->generation) count++;
+		}
+	}
+	return count * 1000 / (sample * TT_BUCKET_SIZE);
+}
@@ -0,0 +1,123 @@
+#ifndef TRANSPOSITION_HPP
+#define TRANSPOSITION_HPP
+
+#include <atomic>
+#include <memory>
+
+#include "constants.hpp"
+
+const uint TT_BUCKET_SIZE = 4;
+const uint TT_GENERATION_MASK = 0b111111;
+
+/**
+ * Type of bound the stored value represents with respect to the true value of the position.
+ */
+enum Bound : uint8_t {
+	BOUND_NONE, BOUND_UPPER, BOUND_LOWER, BOUND_EXACT
+};
+
+/**
+ * Unpacked contents of a transposition table entry.
+ */
+struct TTData {
+	Move move;    // Best (or refutation) move found for the position.
+	float value;  // Value of the position from the perspective of the searcher that stored it.
+	int depth;    // Depth that the position was searched to.
+	Bound bound;  // Bound type of the value.
+};
+
+/**
+ * A lockless transposition table shared by all search threads. Each entry is stored as two 64 bit words, where the
+ * key word is the hash XOR'd with the data word. A torn write (the two words coming from different stores) therefore
+ * fails verification on probe rather than returning corrupted data.
+ */
+class TranspositionTable {
+	public:
+		/**
+		 * @brief Resize the table, discarding all current entries.
+		 *
+		 * @param megabytes Size of the table in megabytes.
+		 */
+		void resize(const size_t megabytes);
+
+		/**
+		 * @brief Zero out every entry of the table, split across the calling thread and the helpers of the thread pool.
+		 * The search must not be running.
+		 */
+		void clear();
+
+		/**
+		 * @brief Increment the table generation. Must be called at the start of each search so that entries from
+		 * older searches are preferred for replacement.
+		 */
+		void newSearch();
+
+		/**
+		 * @brief Look up the position in the table.
+		 *
+		 * @param hash Zobrist hash of the position.
+		 * @param data Populated with the entry contents if found.
+		 * @return True if the position was found, else false.
+		 */
+		bool probe(const Hash hash, TTData& data) const;
+
+		/**
+		 * @brief Store the position in the table. An existing entry for the same position is only overwritten if the
+		 * new entry is exact or is not much shallower. Otherwise, the shallowest and oldest entry in the bucket is
+		 * replaced.
+		 *
+		 * @param hash Zobrist hash of the position.
+		 * @param move Best move of the position. NULL_MOVE keeps the move of any existing entry.
+		 * @param value Value of the position.
+		 * @param depth Depth the position was searched to.
+		 * @param bound Bound type of the value.
+		 */
+		void store(const Hash hash, Move move, const float value, const int depth, const Bound bound);
+
+		/**
+		 * @brief Get the approximate occupancy of the table by entries of the current search.
+		 *
+		 * @return Occupancy in permille, as reported by the UCI "hashfull" info.
+		 */
+		uint hashfull() const;
+
+		/**
+		 * @brief Get the size of the table.
+		 *
+		 * @return Size of the table in bytes.
+		 */
+		inline size_t getSize() const {
+			return this->bucketCount * sizeof(Bucket);
+		}
+
+	private:
+		struct Entry {
+			std::atomic<uint64_t> key;
+			std::atomic<uint64_t> data;
+		};
+
+		struct alignas(CACHE_LINE_SIZE) Bucket {
+			Entry entries[TT_BUCKET_SIZE];
+		};
+
+		std::unique_ptr<Bucket[]> buckets;
+		size_t bucketCount = 0;
+		uint8_t generation = 0;
+
+		/**
+		 * @brief Get the bucket that the position maps to.
+		 *
+		 * @param hash Zobrist hash of the position.
+		 * @return Reference to the bucket.
+		 */
+		inline Bucket& getBucket(const Hash hash) const {
+			return this->buckets[hash % this->bucketCount];
+		}
+};
+
+/**
+ * The transposition table shared by all searchers.
+ */
+extern TranspositionTable TT;
+
+#endif
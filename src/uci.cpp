@@ -1,6 +1,10 @@
 
 #include <iostream>
+#include <cmath>
 #include <thread>
+#include <fstream>
+#include <limits>
+#include <memory>
 #include <algorithm>
 
 
@@ -9,6 +13,10 @@
 #include "utils.hpp"
 #include "sicario.hpp"
 #include "search.hpp"
+#include "transposition.hpp"
+#include "perft.hpp"
+#include "minimax.hpp"
+#include "threadpool.hpp"
 
 void showEogMessage(ExitCode code) {
 	switch (code) {
@@ -48,6 +56,27 @@ inline bool isValidElo(std::string str) {
 	return isPostiveInteger(str) || str == "none";
 }
 
+/**
+ * @brief Find the legal move of a position given in long algebraic notation. The notation does not say whether a move
+ * castles or captures en passant, so the move is matched against the legal moves by its squares and promotion.
+ *
+ * @param position Position to find the move in.
+ * @param string Move in long algebraic notation.
+ * @return The move, or NULL_MOVE if it is not legal.
+ */
+inline Move getLegalMove(Position& position, const std::string& string) {
+	if (string.length() < 4) return NULL_MOVE;
+	const Move parsed = getMovefromAlgebraic(string);
+	if (parsed == NULL_MOVE) return NULL_MOVE;
+
+	for (Move move : MoveList(position)) {
+		if (start(move) != start(parsed) || end(move) != end(parsed)) continue;
+		if (type(move) == PROMOTION && (type(parsed) != PROMOTION || promo(move) != promo(parsed))) continue;
+		return move;
+	}
+	return NULL_MOVE;
+}
+
 void Sicario::processInput(const std::string& input) {
 	std::vector<std::string> commands = split(input, " ");
 	if (commands.size() == 0) return;
@@ -90,6 +119,9 @@ void Sicario::processInput(const std::string& input) {
 		case PERFT:
 			handlePerft(commands);
 			break;
+		case PERFT_SUITE:
+			handlePerftSuite(commands);
+			break;
 		case MOVE:
 			handleMove(commands);
 			break;
@@ -114,6 +146,9 @@ void Sicario::processInput(const std::string& input) {
 		case OPTIONS:
 			handleOptions();
 			break;
+		case BENCH:
+			handleBench(commands);
+			break;
 	}
 }
 
@@ -132,11 +167,13 @@ UciInput Sicario::hashCommandInput(const std::string& input) {
 
 	// Custom command to engine
 	if (input == "perft") return PERFT;
+	if (input == "perftsuite") return PERFT_SUITE;
 	if (input == "move") return MOVE;
 	if (input == "undo") return UNDO;
 	if (input == "display") return DISPLAY;
 	if (input == "moves") return MOVES;
 	if (input == "bitboards") return BITBOARDS;
+	if (input == "bench") return BENCH;
 	if (input == "random") return RANDOMGAME;
 	if (input == "state") return STATE;
 	if (input == "options") return OPTIONS;
@@ -149,7 +186,7 @@ ConfigOption Sicario::hashOptionsInput(const std::vector<std::string>& inputs) {
 
 	if (command == "thread") return THREAD;
 	if (command == "hash") return HASH;
-	if (command == "clear hash") return CLEAR_HASH;
+	if (command == "clearhash") return CLEAR_HASH;
 	if (command == "ponder") return PONDER;
 	if (command == "ownbook") return OWN_BOOK;
 	if (command == "multipv") return MULTI_PV;
@@ -160,6 +197,11 @@ ConfigOption Sicario::hashOptionsInput(const std::vector<std::string>& inputs) {
 	if (command == "uci_analysemode") return UCI_ANALYSE_MODE;
 	if (command == "uci_opponent") return UCI_OPPONENT;
 	if (command == "expandtime") return EXPAND_TIME;
+	if (command == "mctsparallel") return MCTS_PARALLEL;
+	if (command == "rolloutplies") return ROLLOUT_PLIES;
+	if (command == "twofoldrepetition") return TWO_FOLD_REPETITION;
+	if (command == "search") return SEARCH_ALGORITHM;
+	if (command == "evalfile") return EVAL_FILE;
 
 	return UNKNOWN_OPTION;
 }
@@ -234,6 +276,21 @@ void Sicario::handleSetOption(const std::vector<std::string>& inputs) {
 		case EXPAND_TIME:
 			setOptionExpandTime(inputs);
 			break;
+		case MCTS_PARALLEL:
+			setOptionMctsParallel(inputs);
+			break;
+		case ROLLOUT_PLIES:
+			setOptionRolloutPlies(inputs);
+			break;
+		case TWO_FOLD_REPETITION:
+			setOptionTwoFoldRepetition(inputs);
+			break;
+		case SEARCH_ALGORITHM:
+			setOptionSearch(inputs);
+			break;
+		case EVAL_FILE:
+			setOptionEvalFile(inputs);
+			break;
 		case CONFIGS_COUNT:
 			std::cerr << "This should not be happening..." << '\n';
 			assert(false);
@@ -244,35 +301,111 @@ void Sicario::handleSetOption(const std::vector<std::string>& inputs) {
 }
 
 void Sicario::handleUciNewGame() {
-	// TODO Depends on implementation. Will do at end.
+	stopSearch();
+	TT.clear();
+	MctsArena.clear();
+	Threads.clearStates();
 }
 
 void Sicario::handlePosition(const std::vector<std::string>& inputs) {
-	this->position.resetPosition();
+	if (inputs.size() < 2) {
+		sendMissingArgument(inputs);
+		return;
+	}
 
+	const auto movesItr = std::find(inputs.begin(), inputs.end(), "moves");
+	std::string start;
 	if (inputs[1] == "fen") {
-		// this->position.parseFen(concatFEN(inputs));
-		this->position.parseFen(concatFEN(std::vector<std::string>(inputs.begin() + 2, inputs.end())));
+		start = concatFEN(std::vector<std::string>(inputs.begin() + 2, movesItr));
 	} else if (inputs[1] == "startpos") {
-		this->position.parseFen(STANDARD_GAME);
+		start = STANDARD_GAME;
 	} else {
 		sendInvalidArgument(inputs);
 		return;
 	}
+	const std::vector<std::string> moves(movesItr == inputs.end() ? inputs.end() : movesItr + 1, inputs.end());
+
+	// GUIs resend the whole game every move, so keep the moves in common with the last position command and only undo
+	// and make the rest. The game is replayed from the start if it differs or the history cannot be undone far enough.
+	size_t common = 0;
+	if (start == this->positionStart) {
+		const size_t shared = std::min(moves.size(), this->positionMoves.size());
+		while (common < shared && moves[common] == this->positionMoves[common]) common++;
+	}
+	const size_t undos = this->positionMoves.size() - common;
+	if (start != this->positionStart || undos > this->position.getHistory().size()) {
+		this->position.parseFen(start);
+		this->positionMoves.clear();
+		common = 0;
+	} else {
+		for (size_t index = 0; index < undos; index++) this->position.processUndoMove();
+		this->positionMoves.resize(common);
+	}
 
-	auto ptr = std::find(inputs.begin(), inputs.end(), "moves");
-	if (ptr == inputs.end()) return;
-	while (++ptr != inputs.end()) {
-		this->position.processMakeMove(getMovefromAlgebraic(*ptr));
+	this->positionStart = start;
+	for (size_t index = common; index < moves.size(); index++) {
+		const Move move = getLegalMove(this->position, moves[index]);
+		if (move == NULL_MOVE) {
+			Uci::communicate("Invalid move: " + moves[index]);
+			this->positionStart = "";
+			return;
+		}
+		this->position.processMakeMove(move);
+		this->positionMoves.push_back(moves[index]);
 	}
 }
 
 void Sicario::handleGo(const std::vector<std::string>& commands) {
-	// TODO Parse search parameters and utilise number of threads
-	if (this->searchTree == false) {
-		this->searchTree = true;
-		this->threads.push_back(std::thread(&Sicario::search, this));
+	if (this->searchTree == true) return;
+
+	// GUIs may send negative times once a clock has run out, so they are read as signed and clamped. A clock that is
+	// given but empty still counts as a clock, so the search moves at once.
+	SearchLimits limits;
+	auto readTime = [](const std::string& value) {
+		return static_cast<uint64_t>(std::max(std::stoll(value), 0LL));
+	};
+	try {
+		for (size_t index = 1; index < commands.size(); index++) {
+			const std::string& command = commands[index];
+			const bool hasValue = index + 1 < commands.size();
+			if (command == "infinite") {
+				limits.infinite = true;
+			} else if (command == "ponder") {
+				limits.ponder = true;
+			} else if (!hasValue) {
+				continue;
+			} else if (command == "wtime") {
+				limits.time[WHITE] = readTime(commands[++index]);
+				limits.clock[WHITE] = true;
+			} else if (command == "btime") {
+				limits.time[BLACK] = readTime(commands[++index]);
+				limits.clock[BLACK] = true;
+			} else if (command == "winc") {
+				limits.increment[WHITE] = readTime(commands[++index]);
+			} else if (command == "binc") {
+				limits.increment[BLACK] = readTime(commands[++index]);
+			} else if (command == "movestogo") {
+				limits.movesToGo = std::max(std::stoi(commands[++index]), 0);
+			} else if (command == "movetime") {
+				limits.moveTime = readTime(commands[++index]);
+			} else if (command == "nodes") {
+				limits.nodes = readTime(commands[++index]);
+			} else if (command == "depth") {
+				limits.depth = std::max(std::stoi(commands[++index]), 0);
+			}
+		}
+	} catch (const std::logic_error&) {
+		sendInvalidArgument(commands);
+		return;
 	}
+
+	// The previous search has sent its move by now, as it clears searchTree once it has, but may still be returning.
+	Threads[0].wait();
+
+	const uint expandTime = std::stoi(this->sicarioConfigs.options[EXPAND_TIME].value);
+	this->timeManager.start(limits, this->position.getTurn(), expandTime);
+	this->searchTree = true;
+	Threads[0].run([this, root = this->position]() { this->search(root); });
 }
 
 void Sicario::handleStop() {
@@ -280,20 +413,35 @@ void Sicario::handleStop() {
 }
 
 void Sicario::handlePonderHit() {
-	// TODO
+	if (this->searchTree == true) this->timeManager.ponderHit();
 }
 
 void Sicario::handleQuit() {
-	if (this->searchTree == true) this->searchTree = false;
-	for (std::thread& thr : this->threads) {
-		if (thr.joinable()) thr.join();
-	}
+	stopSearch();
 }
 
 void Sicario::handlePerft(const std::vector<std::string>& commands) {
+	// perft <depth> [hash <megabytes>]
+	int depth = 0;
+	std::unique_ptr<PerftTable> table;
+	try {
+		depth = std::max(std::stoi(commands.at(1)), 0);
+		if (commands.size() >= 4 && commands[2] == "hash")
+			table = std::make_unique<PerftTable>(std::max(std::stoi(commands[3]), 0));
+	} catch (const std::logic_error&) {
+		Uci::communicate("Usage: perft <depth> [hash <megabytes>]");
+		return;
+	}
+
+	stopSearch();
 	auto start = std::chrono::high_resolution_clock::now();
-	uint64_t totalNodes = perft(std::stoi(commands[1]), true);
+	Perft perft(this->position, table.get());
+	uint64_t totalNodes = perft.run(depth);
 	auto finish = std::chrono::high_resolution_clock::now();
+	for (const PerftDivide& root : perft.getDivide()) {
+		printMove(root.move, false);
+		std::cout << ": " << root.nodes << '\n';
+	}
 	std::cout << "Nodes searched: " << totalNodes << '\n';
 
 	if (this->sicarioConfigs.debugMode) {
@@ -304,6 +452,78 @@ void Sicario::handlePerft(const std::vector<std::string>& commands) {
 	}
 }
 
+void Sicario::handlePerftSuite(const std::vector<std::string>& commands) {
+	// perftsuite <file> [maxdepth] [hash <megabytes>]
+	const std::string usage = "Usage: perftsuite <file> [maxdepth] [hash <megabytes>]";
+	if (commands.size() < 2) {
+		Uci::communicate(usage);
+		return;
+	}
+
+	int maxDepth = std::numeric_limits<int>::max();
+	std::unique_ptr<PerftTable> table;
+	try {
+		for (size_t index = 2; index < commands.size(); index++) {
+			if (commands[index] == "hash" && index + 1 < commands.size()) {
+				table = std::make_unique<PerftTable>(std::max(std::stoi(commands[++index]), 0));
+			} else {
+				maxDepth = std::stoi(commands[index]);
+			}
+		}
+	} catch (const std::logic_error&) {
+		Uci::communicate(usage);
+		return;
+	}
+
+	std::ifstream file(commands[1]);
+	if (!file) {
+		Uci::communicate("Could not open " + commands[1]);
+		return;
+	}
+
+	// Every line of output is a list of key value pairs, with the FEN (which has spaces) last.
+	stopSearch();
+	uint positions = 0, failures = 0, skipped = 0;
+	uint64_t totalNodes = 0, totalMicroseconds = 0;
+	std::string line;
+	while (std::getline(file, line)) {
+		PerftSuiteEntry entry;
+		if (!parsePerftSuiteLine(line, entry)) continue;
+		positions++;
+
+		Position position(entry.fen);
+		Perft perft(position, table.get());
+		bool passed = true, ran = false;
+		uint64_t nodes = 0;
+		auto start = std::chrono::high_resolution_clock::now();
+		for (const auto& [depth, expected] : entry.expected) {
+			if (depth > maxDepth) continue;
+			uint64_t count = perft.run(depth);
+			ran = true;
+			nodes += count;
+			passed &= count == expected;
+			std::cout << "perftsuite position " << positions << " depth " << depth << " nodes " << count <<
+					" expected " << expected << " result " << (count == expected ? "pass" : "fail") << '\n';
+		}
+		auto finish = std::chrono::high_resolution_clock::now();
+		uint64_t microseconds = std::chrono::duration_cast<std::chrono::microseconds>(finish - start).count();
+
+		// Positions with every depth above the maximum are reported but not counted as passed.
+		const std::string result = !ran ? "skip" : passed ? "pass" : "fail";
+		failures += !passed;
+		skipped += !ran;
+		totalNodes += nodes;
+		totalMicroseconds += microseconds;
+		std::cout << "perftsuite position " << positions << " nodes " << nodes << " time " << microseconds / 1000 <<
+				" nps " << nodes * 1000000 / std::max(microseconds, static_cast<uint64_t>(1)) << " result " << result <<
+				" fen " << entry.fen << std::endl;
+	}
+
+	std::cout << "perftsuite total positions " << positions << " passed " << positions - failures - skipped <<
+			" failed " << failures << " skipped " << skipped << " nodes " << totalNodes << " time " <<
+			totalMicroseconds / 1000 << " nps " << totalNodes * 1000000 / std::max(totalMicroseconds, static_cast<uint64_t>(1)) << std::endl;
+}
+
 void Sicario::handleMove(const std::vector<std::string>& commands) {
 	Move move = getMovefromAlgebraic(commands[1]);
 	if (move == NULL_MOVE) {
@@ -317,6 +537,7 @@ void Sicario::handleMove(const std::vector<std::string>& commands) {
 		return;
 	}
 
+	this->positionStart = "";
 	if (moves.contains(move)) {
 		this->position.processMakeMove(move);
 	} else {
@@ -325,6 +546,7 @@ void Sicario::handleMove(const std::vector<std::string>& commands) {
 }
 
 void Sicario::handleUndo() {
+	this->positionStart = "";
 	this->position.processUndoMove();
 }
 
@@ -377,6 +599,31 @@ void Sicario::handleOptions() {
 	}
 }
 
+void Sicario::handleBench(const std::vector<std::string>& commands) {
+	const int duration = commands.size() > 1 ? std::stoi(commands[1]) : DEFAULT_BENCH_TIME;
+	stopSearch();
+	uint64_t totalPlayouts = 0;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (const std::string& fen : BENCH_POSITIONS) {
+		std::atomic_bool running = true;
+		Position position(fen);
+		TimeManager timeManager; // No limits, the timer thread stops the search.
+		Mcts searcher(position, Threads[0].getState(), running, timeManager, this->sicarioConfigs);
+		std::thread timer([&running, duration]() {
+			std::this_thread::sleep_for(std::chrono::milliseconds(duration));
+			running = false;
+		});
+		searcher.run(false);
+		timer.join();
+		totalPlayouts += searcher.getPlayouts();
+	}
+	auto finish = std::chrono::high_resolution_clock::now();
+
+	uint64_t elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(finish - start).count();
+	std::cout << "Playouts searched: " << totalPlayouts << '\n';
+	std::cout << "Playouts/second: " << totalPlayouts * 1000 / std::max(elapsed, static_cast<uint64_t>(1)) << '\n';
+}
+
 void Uci::communicate(std::string communication) {
 	std::cout << communication << '\n';
 }
@@ -385,26 +632,73 @@ void Uci::sendReadyOk() {
 	Uci::communicate("readyok");
 }
 
-void Uci::sendBestMove(MctsNode* root, bool debugMode) {
-	std::cout << "bestmove ";
-	printMove(root->bestChild()->getInEdge(), false, true);
+void Uci::sendBestMove(const std::vector<MctsNode*>& roots, bool debugMode, bool ponder) {
+	// Merge the root children of every tree by move. A shared tree only has the one root.
+	std::vector<Move> moves;
+	std::vector<float> values;
+	std::vector<uint> visits;
+	uint rootVisits = 0;
+	for (MctsNode* root : roots) {
+		rootVisits += root->getVisits();
+		for (MctsNode& child : root->getChildren()) {
+			size_t index = std::find(moves.begin(), moves.end(), child.getInEdge()) - moves.begin();
+			if (index == moves.size()) {
+				moves.push_back(child.getInEdge());
+				values.push_back(0);
+				visits.push_back(0);
+			}
+			values[index] += child.getValue();
+			visits[index] += child.getVisits();
+		}
+	}
+
+	std::vector<float> ucb1Values;
+	for (size_t index = 0; index < moves.size(); index++)
+		ucb1Values.push_back(ucb1(values[index], visits[index], rootVisits));
+
+	if (moves.empty()) {
+		sendBestMove(NULL_MOVE);
+		return;
+	}
+	const Move bestMove = moves[std::max_element(ucb1Values.begin(), ucb1Values.end()) - ucb1Values.begin()];
+
+	// The expected reply is the most visited child of the best move, in the tree that visited the best move most.
+	Move reply = NULL_MOVE;
+	if (ponder) {
+		MctsNode* best = nullptr;
+		for (MctsNode* root : roots) {
+			MctsNode* child = root->findChild(bestMove);
+			if (child != nullptr && (best == nullptr || child->getVisits() > best->getVisits())) best = child;
+		}
+		MctsNode* bestReply = best != nullptr ? best->mostVisitedChild() : nullptr;
+		if (bestReply != nullptr) reply = bestReply->getInEdge();
+	}
+	sendBestMove(bestMove, reply);
 
 	if (!debugMode) return;
 
-	std::vector<float> ucb1Values;
-	for (auto child : root->getChildren())
-		ucb1Values.push_back(child->Ucb1());
 	std::vector<size_t> ucbRanks = rankSort(ucb1Values);
+	for (size_t index = 0; index < moves.size(); index++) {
+		printMove(moves[index], true);
+		std::cout << "\tValue: " << values[index];
+		std::cout << "\tVisits: " << visits[index];
+		std::cout << "\tUCB1: " << ucb1Values[index];
+		std::cout << "\tRank: " << ucbRanks[index] << '\n';
+	}
+}
 
-	for (auto child : root->getChildren()) {
-		printMove(child->getInEdge(), true);
-		std::cout << "\tValue: " << child->getValue();
-		std::cout << "\tVisits: " << child->getVisits();
-		std::cout << "\tUCB1: " << ucb1Values.front();
-		std::cout << "\tRank: " << ucbRanks.front() << '\n';
-		ucb1Values.erase(ucb1Values.begin());
-		ucbRanks.erase(ucbRanks.begin());
+void Uci::sendBestMove(const Move move, const Move ponder) {
+	std::cout << "bestmove ";
+	if (move == NULL_MOVE) {
+		std::cout << "0000" << std::endl;
+		return;
+	}
+	printMove(move, false);
+	if (ponder != NULL_MOVE) {
+		std::cout << " ponder ";
+		printMove(ponder, false);
 	}
+	std::cout << std::endl;
 }
 
 void Uci::sendCopyProtection() {
@@ -416,7 +710,26 @@ void Uci::sendRegistration() {
 }
 
 void Uci::sendInfo(SearchInfo& searchInfo) {
-	std::cout << "depth " << searchInfo.depth << '\n';
+	std::cout << "info depth " << searchInfo.depth << " hashfull " << searchInfo.hashfull << '\n';
+}
+
+void Uci::sendIterationInfo(const int depth, const int value, const uint64_t nodes, const uint64_t milliseconds,
+		const std::vector<Move>& pv) {
+	std::cout << "info depth " << depth << " score ";
+	if (std::abs(value) >= MATE_BOUND) {
+		// Moves rather than plies to mate, negative if the player to move is being mated.
+		const int plies = MATE_VALUE - std::abs(value);
+		std::cout << "mate " << (value > 0 ? (plies + 1) / 2 : -(plies / 2));
+	} else {
+		std::cout << "cp " << value;
+	}
+	std::cout << " nodes " << nodes << " nps " << nodes * 1000 / std::max(milliseconds, static_cast<uint64_t>(1)) <<
+			" time " << milliseconds << " pv";
+	for (Move move : pv) {
+		std::cout << ' ';
+		printMove(move, false);
+	}
+	std::cout << std::endl;
 }
 
 void Uci::sendOption(const OptionInfo& option) {
@@ -458,6 +771,8 @@ void Sicario::setOptionThread(const std::vector<std::string>& inputs) {
 		return;
 	}
 	option.value = value;
+	stopSearch();
+	Threads.resize(std::stoi(value));
 }
 
 void Sicario::setOptionHash(const std::vector<std::string>& inputs) {
@@ -468,10 +783,14 @@ void Sicario::setOptionHash(const std::vector<std::string>& inputs) {
 		return;
 	}
 	option.value = value;
+	stopSearch();
+	resizeHash(std::stoi(value));
 }
 
 void Sicario::setOptionClearHash() {
-	// TODO
+	stopSearch();
+	TT.clear();
+	MctsArena.clear();
 }
 
 void Sicario::setOptionPonder(const std::vector<std::string>& inputs) {
@@ -575,6 +894,65 @@ void Sicario::setOptionExpandTime(const std::vector<std::string>& inputs) {
 	option.value = value;
 }
 
+void Sicario::setOptionMctsParallel(const std::vector<std::string>& inputs) {
+	std::string value = getOptionValue(inputs);
+	OptionInfo& option = sicarioConfigs.options[MCTS_PARALLEL];
+	if (std::find(option.vars.begin(), option.vars.end(), value) != option.vars.end()) {
+		option.value = value;
+	} else {
+		sendInvalidArgument(inputs);
+	}
+}
+
+void Sicario::setOptionRolloutPlies(const std::vector<std::string>& inputs) {
+	std::string value = getOptionValue(inputs);
+	OptionInfo& option = sicarioConfigs.options[ROLLOUT_PLIES];
+	if (std::stoi(value) < std::stoi(option.min) || std::stoi(value) > std::stoi(option.max)) {
+		sendArgumentOutOfRange(inputs);
+		return;
+	}
+	option.value = value;
+}
+
+void Sicario::setOptionTwoFoldRepetition(const std::vector<std::string>& inputs) {
+	std::string value = getOptionValue(inputs);
+	OptionInfo& option = sicarioConfigs.options[TWO_FOLD_REPETITION];
+	if (value == "true" || value == "false") {
+		option.value = value;
+	} else {
+		sendInvalidArgument(inputs);
+	}
+}
+
+void Sicario::setOptionSearch(const std::vector<std::string>& inputs) {
+	std::string value = getOptionValue(inputs);
+	OptionInfo& option = sicarioConfigs.options[SEARCH_ALGORITHM];
+	if (std::find(option.vars.begin(), option.vars.end(), value) != option.vars.end()) {
+		if (value == option.value) return;
+		option.value = value;
+		stopSearch();
+		resizeHash(std::stoi(sicarioConfigs.options[HASH].value));
+	} else {
+		sendInvalidArgument(inputs);
+	}
+}
+
+void Sicario::setOptionEvalFile(const std::vector<std::string>& inputs) {
+	std::string value = getOptionValue(inputs);
+	OptionInfo& option = sicarioConfigs.options[EVAL_FILE];
+	stopSearch();
+	if (value == "" || value == "<empty>") {
+		Nnue.unload();
+		option.value = "";
+	} else if (Nnue.load(value)) {
+		option.value = value;
+	} else {
+		sendInvalidValue(inputs);
+		return;
+	}
+	this->position.refreshAccumulator();
+}
+
 std::string Sicario::getOptionName(const std::vector<std::string>& inputs) {
 	auto nameItr = std::find(inputs.begin(), inputs.end(), "name");
 	auto valueItr = std::find(inputs.begin(), inputs.end(), "value");
@@ -20,12 +20,22 @@ namespace Uci {
 	void sendReadyOk();
 
 	/**
-	 * @brief Send the bestmove message.
+	 * @brief Send the bestmove message. The child statistics of all roots are merged by move before choosing.
 	 *
-	 * @param root Pointer to McstNode object that is the root of the search tree.
+	 * @param roots Pointers to MctsNode objects that are the roots of the search trees. Contains one root per worker
+	 * for a root parallel search, else a single root.
 	 * @param debugMode Flag to display information on all children. Used for development and debugging.
+	 * @param ponder Flag to also send the most visited reply to the best move, for the GUI to ponder on.
 	 */
-	void sendBestMove(MctsNode* root, bool debugMode);
+	void sendBestMove(const std::vector<MctsNode*>& roots, bool debugMode, bool ponder);
+
+	/**
+	 * @brief Send the bestmove message of a search that found a single best move.
+	 *
+	 * @param move Best move, or NULL_MOVE if the position has no moves.
+	 * @param ponder Expected reply to the best move, for the GUI to ponder on, or NULL_MOVE to send none.
+	 */
+	void sendBestMove(const Move move, const Move ponder = NULL_MOVE);
 
 	/**
 	 * @brief Send the copyProtection message.
@@ -44,6 +54,18 @@ namespace Uci {
 	 */
 	void sendInfo(SearchInfo& searchInfo);
 
+	/**
+	 * @brief Send the info message of a completed iteration of an alpha-beta search.
+	 *
+	 * @param depth Depth of the iteration.
+	 * @param value Value of the root in centipawns from the perspective of the player to move.
+	 * @param nodes Nodes searched so far.
+	 * @param milliseconds Time searched so far.
+	 * @param pv Principal variation of the iteration.
+	 */
+	void sendIterationInfo(const int depth, const int value, const uint64_t nodes, const uint64_t milliseconds,
+			const std::vector<Move>& pv);
+
 	/**
 	 * @brief Send the options that the user can set.
 	 *
@@ -1,6 +1,7 @@
 #include <bitset>
 #include <iostream>
 #include <algorithm>
+#include <atomic>
 
 #include "utils.hpp"
 #include "constants.hpp"
@@ -57,7 +58,7 @@ void printMove(const Move move, const bool extraInfo, const bool flush) {
 		std::cout << squareName[start(move)] << squareName[end(move)];
 	}
 
-	if (flush) std::cout << '\n';
+	if (flush) std::cout << std::endl;
 }
 
 std::string getPromoString(const Promotion promo) {
@@ -142,4 +143,16 @@ std::vector<size_t> rankSort(const std::vector<float>& v_temp) {
 
 Square mirror(Square square) {
 	return static_cast<Square>(static_cast<int>(square) ^ 56);
-}
\ No newline at end of file
+}
+
+Prng& threadPrng() {
+	// Spread consecutive seeds with splitmix64 so the threads' sequences are unrelated.
+	static std::atomic<uint64_t> seeds = 0;
+	thread_local Prng prng = [] {
+		uint64_t seed = (seeds.fetch_add(1, std::memory_order_relaxed) + 1) * 0x9E3779B97F4A7C15ULL;
+		seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBULL;
+		return Prng((seed ^ (seed >> 31)) | 1);
+	}();
+	return prng;
+}
@@ -2,6 +2,7 @@
 #define UTILS_HPP
 
 #include "constants.hpp"
+#include <bit>
 #include <vector>
 #include <string>
 #include <cassert>
@@ -49,6 +50,16 @@ inline bool oneBitSet(Bitboard bitboard) {
 	return bitboard && !(bitboard & (bitboard - ONE_BB));
 }
 
+/**
+ * @brief Counts the bits set in a bitboard.
+ *
+ * @param bitboard The bitboard to count.
+ * @return Number of bits set.
+ */
+inline uint bitCount(Bitboard bitboard) {
+	return std::popcount(bitboard);
+}
+
 /**
  * @brief Checks if the given square is dark square.
  *
@@ -181,4 +192,49 @@ inline bool isSet(T number, uint index) {
 	return number & (static_cast<T>(1) << index);
 }
 
-#endif
\ No newline at end of file
+/**
+ * A small and fast xorshift64* pseudo random number generator. Only suitable for things like choosing rollout moves.
+ */
+class Prng {
+	public:
+		/**
+		 * @brief Initialise the generator.
+		 *
+		 * @param seed Seed of the generator. Must be non-zero.
+		 */
+		explicit Prng(const uint64_t seed) : state(seed) {}
+
+		/**
+		 * @brief Get the next random number.
+		 *
+		 * @return Random 64 bit number.
+		 */
+		inline uint64_t next() {
+			this->state ^= this->state >> 12;
+			this->state ^= this->state << 25;
+			this->state ^= this->state >> 27;
+			return this->state * 0x2545F4914F6CDD1DULL;
+		}
+
+		/**
+		 * @brief Get a random number in the range [0, bound).
+		 *
+		 * @param bound Exclusive upper bound. Must be non-zero.
+		 * @return Random number less than bound.
+		 */
+		inline uint bounded(const uint bound) {
+			return static_cast<uint>(((next() >> 32) * bound) >> 32);
+		}
+
+	private:
+		uint64_t state;
+};
+
+/**
+ * @brief Get the generator of the calling thread. Each thread's generator is seeded differently.
+ *
+ * @return Reference to the thread local generator.
+ */
+Prng& threadPrng();
+
+#endif
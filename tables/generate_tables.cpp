@@ -0,0 +1,237 @@
+#include <cctype>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "../src/constants.hpp"
+#include "../src/movegen.hpp"
+
+// Writes every precomputed table of the engine as constant data, so that nothing has to be computed at startup. Run by
+// the Makefile before building the engine, with the same flags, since some indices depend on USE_PEXT.
+
+const uint VALUES_PER_LINE = 16;
+
+/**
+ * @brief Write the values as the body of an array initialiser.
+ *
+ * @param out Stream to write to.
+ * @param values Values to write.
+ * @param format Formats a single value.
+ */
+template<typename T>
+void writeValues(std::ostream& out, const std::vector<T>& values, std::function<std::string(const T&)> format) {
+	for (size_t i = 0; i < values.size(); i++) {
+		out << (i % VALUES_PER_LINE == 0 ? "\t" : " ") << format(values[i]) << ",";
+		if (i % VALUES_PER_LINE == VALUES_PER_LINE - 1 || i == values.size() - 1) out << '\n';
+	}
+}
+
+std::string formatBitboard(const Bitboard& bitboard) {
+	std::stringstream stream;
+	stream << "0x" << std::hex << std::setw(16) << std::setfill('0') << bitboard << "ULL";
+	return stream.str();
+}
+
+std::string formatSquare(const Square& square) {
+	std::string name = squareName[square];
+	for (char& c : name) c = std::toupper(c);
+	return name;
+}
+
+std::string formatSpan(const TableSpan& span) {
+	std::stringstream stream;
+	stream << "{" << span.offset << ", " << span.length << "}";
+	return stream.str();
+}
+
+template<typename T>
+std::string formatNumber(const T& value) {
+	return std::to_string(value);
+}
+
+/**
+ * @brief Write a flat array and the rows of a SquareTable over it.
+ *
+ * @param out Stream to write to.
+ * @param type Type of the values.
+ * @param array Name of the flat array.
+ * @param family Values of each square.
+ * @param format Formats a single value.
+ * @return Initialiser of the rows of the table.
+ */
+template<typename T>
+std::string writeSquareTable(std::ostream& out, const std::string& type, const std::string& array,
+		const std::array<std::vector<T>, SQUARE_COUNT>& family, std::function<std::string(const T&)> format) {
+	std::vector<T> values;
+	std::string rows = "{";
+	for (Square square = A1; square <= H8; square++) {
+		rows += (square == A1 ? "" : ", ") + array + " + " + std::to_string(values.size());
+		values.insert(values.end(), family[square].begin(), family[square].end());
+	}
+	rows += "}";
+
+	out << "\tconst " << type << " " << array << "[] = {\n";
+	writeValues(out, values, format);
+	out << "\t};\n\n";
+	return rows;
+}
+
+/**
+ * @brief Write the values and spans arrays of a SetPool.
+ *
+ * @param out Stream to write to.
+ * @param type Type of the values.
+ * @param name Prefix of the array names.
+ * @param pool Pool to write.
+ * @param format Formats a single value.
+ */
+template<typename T>
+void writeSetPool(std::ostream& out, const std::string& type, const std::string& name, const SetPool<T>& pool,
+		std::function<std::string(const T&)> format) {
+	out << "\tconst " << type << " " << name << "_VALUES[] = {\n";
+	writeValues(out, pool.getValues(), format);
+	out << "\t};\n\n";
+	out << "\tconst TableSpan " << name << "_SPANS[] = {\n";
+	writeValues<TableSpan>(out, pool.getSpans(), formatSpan);
+	out << "\t};\n\n";
+}
+
+/**
+ * @brief Get the initialiser of a SetTable over a SetPool.
+ *
+ * @param name Prefix of the array names of the pool.
+ * @param pool Pool the table is over.
+ * @param family Position of the family of the table in the pool.
+ * @return Initialiser of the table.
+ */
+template<typename T>
+std::string setTable(const std::string& name, const SetPool<T>& pool, const uint family) {
+	std::string rows = "{";
+	for (Square square = A1; square <= H8; square++)
+		rows += (square == A1 ? "" : ", ") + name + "_SPANS + " + std::to_string(pool.getRow(family, square));
+	return "(" + name + "_VALUES, " + rows + "})";
+}
+
+template<typename T, size_t N>
+std::string arrayInitialiser(const std::array<T, N>& values, std::function<std::string(const T&)> format) {
+	std::string result = "{";
+	for (size_t i = 0; i < N; i++) result += (i == 0 ? "" : ", ") + format(values[i]);
+	return result + "}";
+}
+
+std::string singleMove(const std::vector<Move>& moves) {
+	std::stringstream stream;
+	stream << "{" << moves.at(0) << "}";
+	return stream.str();
+}
+
+int main(int argc, char* argv[]) {
+	if (argc != 2) {
+		std::cerr << "Usage: " << argv[0] << " <output file>\n";
+		return EXIT_FAILURE;
+	}
+
+	std::ofstream out(argv[1]);
+	out << "// Generated by tables/generate_tables. Do not edit.\n\n";
+	out << "#include \"tables.hpp\"\n\n";
+	out << "namespace {\n";
+
+	const MovePool moves({
+		computeKingMoves(),
+		computeRookMoves(),
+		computeBishopMoves(),
+		computeKnightMoves(),
+		computePawnMovesBySide(BLACK),
+		computePawnMovesBySide(WHITE),
+		computeRookBlockMoves(),
+		computeBishopBlockMoves()
+	});
+	writeSetPool<Move>(out, "Move", "MOVE", moves, formatNumber<Move>);
+
+	const SetPool<Square> kingReach({computeKingReachSquares()});
+	writeSetPool<Square>(out, "Square", "KING_REACH", kingReach, formatSquare);
+
+	std::string rookIndices = writeSquareTable<uint>(out, "uint", "ROOK_INDICES", computeRookReachIndices(),
+			formatNumber<uint>);
+	std::string bishopIndices = writeSquareTable<uint>(out, "uint", "BISHOP_INDICES", computeBishopReachIndices(),
+			formatNumber<uint>);
+	std::string rookReach = writeSquareTable<Bitboard>(out, "Bitboard", "ROOK_REACH", computeRookReaches(),
+			formatBitboard);
+	std::string bishopReach = writeSquareTable<Bitboard>(out, "Bitboard", "BISHOP_REACH", computeBishopReaches(),
+			formatBitboard);
+	std::string levelRays = writeSquareTable<Bitboard>(out, "Bitboard", "LEVEL_RAYS", computeLevelRays(),
+			formatBitboard);
+	std::string diagonalRays = writeSquareTable<Bitboard>(out, "Bitboard", "DIAGONAL_RAYS", computeDiagonalRays(),
+			formatBitboard);
+	out << "}\n\n";
+
+	std::array<MoveVector, CASTLING_OPTIONS> castling = computeCastlingMoves();
+	std::array<std::vector<MoveFamily>, PLAYER_COUNT> enPassant = computeEnPassantMoves();
+	std::array<std::string, PLAYER_COUNT> enPassantSides;
+	for (uint player = BLACK; player <= WHITE; player++) {
+		for (uint file = 0; file < FILE_COUNT; file++) {
+			enPassantSides[player] += std::string(file == 0 ? "{{" : ", ") + "{{" +
+					singleMove(enPassant[player].at(file).at(0)) + ", " + singleMove(enPassant[player].at(file).at(1)) +
+					"}}";
+		}
+		enPassantSides[player] += "}}";
+	}
+
+	out << "namespace Moves {\n";
+	out << "\tconstinit const MoveTable KING" << setTable("MOVE", moves, KING_MOVES) << ";\n";
+	out << "\tconstinit const MoveTable ROOK" << setTable("MOVE", moves, ROOK_MOVES) << ";\n";
+	out << "\tconstinit const MoveTable BISHOP" << setTable("MOVE", moves, BISHOP_MOVES) << ";\n";
+	out << "\tconstinit const MoveTable KNIGHT" << setTable("MOVE", moves, KNIGHT_MOVES) << ";\n";
+	out << "\tconstinit const std::array<MoveTable, PLAYER_COUNT> PAWN = {MoveTable" <<
+			setTable("MOVE", moves, BLACK_PAWN_MOVES) << ", MoveTable" << setTable("MOVE", moves, WHITE_PAWN_MOVES) <<
+			"};\n";
+	out << "\tconstinit const std::array<std::array<Move, 1>, CASTLING_OPTIONS> CASTLING = {{" <<
+			singleMove(castling[0]) << ", " << singleMove(castling[1]) << ", " << singleMove(castling[2]) << ", " <<
+			singleMove(castling[3]) << "}};\n";
+	out << "\tconstinit const std::array<std::array<std::array<std::array<Move, 1>, 2>, FILE_COUNT>, PLAYER_COUNT> "
+			"EN_PASSANT = {{\n\t\t" << enPassantSides[BLACK] << ",\n\t\t" << enPassantSides[WHITE] << "\n\t}};\n";
+	out << "}\n\n";
+
+	out << "namespace Moves::Blocks {\n";
+	out << "\tconstinit const MoveTable ROOK" << setTable("MOVE", moves, ROOK_BLOCK_MOVES) << ";\n";
+	out << "\tconstinit const MoveTable BISHOP" << setTable("MOVE", moves, BISHOP_BLOCK_MOVES) << ";\n";
+	out << "}\n\n";
+
+	out << "namespace Indices {\n";
+	out << "\tconstinit const SquareTable<uint> ROOK(" << rookIndices << ");\n";
+	out << "\tconstinit const SquareTable<uint> BISHOP(" << bishopIndices << ");\n";
+	out << "}\n\n";
+
+	out << "namespace Reach {\n";
+	out << "\tconstinit const SquareTable<Bitboard> ROOK(" << rookReach << ");\n";
+	out << "\tconstinit const SquareTable<Bitboard> BISHOP(" << bishopReach << ");\n";
+	out << "}\n\n";
+
+	out << "namespace KingReach {\n";
+	out << "\tconstinit const SetTable<Square> SQUARES" << setTable("KING_REACH", kingReach, 0) << ";\n";
+	out << "}\n\n";
+
+	out << "namespace Rays {\n";
+	out << "\tconstinit const SquareTable<Bitboard> LEVEL(" << levelRays << ");\n";
+	out << "\tconstinit const SquareTable<Bitboard> DIAGONAL(" << diagonalRays << ");\n";
+	out << "}\n\n";
+
+	std::array<std::array<Hash, SQUARE_COUNT>, PIECE_TYPE_COUNT> pieceHashes = generatePieceHashes();
+	out << "namespace Hashes {\n";
+	out << "\tconstinit const std::array<std::array<Hash, SQUARE_COUNT>, PIECE_TYPE_COUNT> PIECES = {{\n";
+	for (uint piece = 0; piece < PIECE_TYPE_COUNT; piece++) {
+		out << "\t\t" << arrayInitialiser<Hash, SQUARE_COUNT>(pieceHashes[piece], formatBitboard) <<
+				(piece == PIECE_TYPE_COUNT - 1 ? "\n" : ",\n");
+	}
+	out << "\t}};\n";
+	out << "\tconstinit const Hash TURN = " << formatBitboard(generateTurnHash()) << ";\n";
+	out << "\tconstinit const std::array<Hash, CASTLING_COMBOS> CASTLING = " <<
+			arrayInitialiser<Hash, CASTLING_COMBOS>(generateCastlingHash(), formatBitboard) << ";\n";
+	out << "\tconstinit const std::array<Hash, FILE_COUNT> EN_PASSANT = " <<
+			arrayInitialiser<Hash, FILE_COUNT>(generateEnPassantHash(), formatBitboard) << ";\n";
+	out << "}\n";
+
+	return out ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -1,12 +1,21 @@
 #include <iostream>
+#include <fstream>
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
 #include <cmath>
+#include <random>
+#include <filesystem>
+#include <algorithm>
 #include "../src/constants.hpp"
 #include "../src/movegen.hpp"
 #include "../src/utils.hpp"
+#include "../src/game.hpp"
+#include "../src/perft.hpp"
+#include "../src/nnue.hpp"
+#include "../src/timemanager.hpp"
+#include "../src/sicario.hpp"
 
 #define GREEN = "\033[0;32m"
 #define RED = "\033[0;31m"
@@ -22,7 +31,16 @@ enum TestType {
 	BLACK_PAWN_MAGIC_NUMS,
 	WHITE_PAWN_MAGIC_NUMS,
 	ROOK_BLOCK_MAGIC_NUMS,
-	BISHOP_BLOCK_MAGIC_NUMS
+	BISHOP_BLOCK_MAGIC_NUMS,
+	REPETITION,
+	GET_FEN,
+	INCREMENTAL_EVALUATION,
+	INCREMENTAL_PHASE,
+	NNUE_ACCUMULATOR,
+	NNUE_EVALUATE,
+	TIME_MANAGER,
+	POSITION_COMMAND,
+	LEGAL_MOVE
 };
 
 std::unordered_map<TestType, int> TESTS_COUNTS = {
@@ -35,7 +53,16 @@ std::unordered_map<TestType, int> TESTS_COUNTS = {
 	{BLACK_PAWN_MAGIC_NUMS, 0},
 	{WHITE_PAWN_MAGIC_NUMS, 0},
 	{ROOK_BLOCK_MAGIC_NUMS, 0},
-	{BISHOP_BLOCK_MAGIC_NUMS, 0}
+	{BISHOP_BLOCK_MAGIC_NUMS, 0},
+	{REPETITION, 0},
+	{GET_FEN, 0},
+	{INCREMENTAL_EVALUATION, 0},
+	{INCREMENTAL_PHASE, 0},
+	{NNUE_ACCUMULATOR, 0},
+	{NNUE_EVALUATE, 0},
+	{TIME_MANAGER, 0},
+	{POSITION_COMMAND, 0},
+	{LEGAL_MOVE, 0}
 };
 
 std::unordered_map<TestType, std::string> TESTS_NAMES = {
@@ -48,7 +75,16 @@ std::unordered_map<TestType, std::string> TESTS_NAMES = {
 	{BLACK_PAWN_MAGIC_NUMS, "blackPawnMagicNums"},
 	{WHITE_PAWN_MAGIC_NUMS, "whitePawnMagicNums"},
 	{ROOK_BLOCK_MAGIC_NUMS, "rookBlockMagicNums"},
-	{BISHOP_BLOCK_MAGIC_NUMS, "bishopBlockMagicNums"}
+	{BISHOP_BLOCK_MAGIC_NUMS, "bishopBlockMagicNums"},
+	{REPETITION, "isRepetition"},
+	{GET_FEN, "getFen"},
+	{INCREMENTAL_EVALUATION, "incrementalEvaluation"},
+	{INCREMENTAL_PHASE, "incrementalPhase"},
+	{NNUE_ACCUMULATOR, "nnueAccumulator"},
+	{NNUE_EVALUATE, "nnueEvaluate"},
+	{TIME_MANAGER, "timeManager"},
+	{POSITION_COMMAND, "handlePosition"},
+	{LEGAL_MOVE, "isLegal"}
 };
 
 int TOTAL_TEST_COUNT = 0;
@@ -728,6 +764,434 @@ void run_bishopBlockMagicNums_tests() {
 	}
 }
 
+/**
+ * @brief Make moves given in long algebraic notation, as in the position command.
+ *
+ * @param position Position to make the moves on.
+ * @param moves Moves separated by spaces. Each must be legal.
+ */
+void makeMoves(Position& position, const std::string& moves) {
+	for (const std::string& string : split(moves, " ")) {
+		if (string.empty()) continue;
+		const Move parsed = getMovefromAlgebraic(string);
+		for (Move move : MoveList(position)) {
+			if (start(move) != start(parsed) || end(move) != end(parsed)) continue;
+			if (type(move) == PROMOTION && (type(parsed) != PROMOTION || promo(move) != promo(parsed))) continue;
+			position.processMakeMove(move);
+			break;
+		}
+	}
+}
+
+void run_isRepetition_tests() {
+	const std::string KNIGHTS_OUT_AND_BACK = "g1f3 g8f6 f3g1 f6g8 ";
+
+	// Threefold repetition of the starting position.
+	Position position;
+	makeMoves(position, KNIGHTS_OUT_AND_BACK);
+	assertEquals(REPETITION, false, position.isDrawn(), 1);
+	makeMoves(position, "g1f3 g8f6 f3g1");
+	assertEquals(REPETITION, false, position.isDrawn(), 2);
+	makeMoves(position, "f6g8");
+	assertEquals(REPETITION, true, position.isDrawn(), 3);
+	MoveList moves(position);
+	assertEquals(REPETITION, THREE_FOLD_REPETITION, position.isEOG(moves), 4);
+	position.processUndoMove();
+	assertEquals(REPETITION, false, position.isDrawn(), 5);
+
+	// Repetitions from a FEN, with the repeated position reached by a different move order.
+	position.parseFen("4k3/8/8/8/8/8/8/R3K3 w - - 10 40");
+	makeMoves(position, "a1a2 e8d8 a2a1 d8e8 e1d1 e8d8 d1e1");
+	assertEquals(REPETITION, false, position.isDrawn(), 6);
+	makeMoves(position, "d8e8");
+	assertEquals(REPETITION, true, position.isDrawn(), 7);
+
+	// Twofold repetition only counts for a position repeated after the root.
+	position.parseFen(STANDARD_GAME);
+	position.setSearchRoot(true);
+	makeMoves(position, KNIGHTS_OUT_AND_BACK);
+	assertEquals(REPETITION, false, position.isDrawn(), 8);
+	makeMoves(position, "g1f3");
+	assertEquals(REPETITION, true, position.isDrawn(), 9);
+
+	position.parseFen(STANDARD_GAME);
+	position.setSearchRoot(false);
+	makeMoves(position, KNIGHTS_OUT_AND_BACK + "g1f3");
+	assertEquals(REPETITION, false, position.isDrawn(), 10);
+
+	position.parseFen(STANDARD_GAME);
+	makeMoves(position, KNIGHTS_OUT_AND_BACK);
+	position.setSearchRoot(true);
+	makeMoves(position, "g1f3");
+	assertEquals(REPETITION, false, position.isDrawn(), 11);
+	makeMoves(position, "b8c6 b1c3 c6b8 c3b1 b8c6");
+	assertEquals(REPETITION, true, position.isDrawn(), 12);
+
+	// Positions before a pawn move are not counted, as the halfmove clock bounds the scan.
+	position.parseFen(STANDARD_GAME);
+	makeMoves(position, KNIGHTS_OUT_AND_BACK + "e2e4 e7e6 " + KNIGHTS_OUT_AND_BACK + "g1f3 g8f6 f3g1");
+	assertEquals(REPETITION, false, position.isDrawn(), 13);
+	makeMoves(position, "f6g8");
+	assertEquals(REPETITION, true, position.isDrawn(), 14);
+
+	// The halfmove clock of a FEN may exceed the history, which the scan must not read past.
+	position.parseFen("4k3/8/8/8/8/8/8/R3K3 w - - 90 60");
+	makeMoves(position, "a1a2 e8d8 a2a1");
+	assertEquals(REPETITION, false, position.isDrawn(), 15);
+
+	// The fifty move rule.
+	position.parseFen("4k3/8/8/8/8/8/8/R3K3 w - - 98 80");
+	makeMoves(position, "a1a2");
+	assertEquals(REPETITION, false, position.isDrawn(), 16);
+	makeMoves(position, "e8d8");
+	assertEquals(REPETITION, true, position.isDrawn(), 17);
+}
+
+// Depth of the make/undo walks over the perft suite. Every position of the walk is compared with a fresh parse.
+const int PERFT_SUITE_WALK_DEPTH = 3;
+
+/**
+ * @brief Load the perft suite, which sits next to this file.
+ *
+ * @return Entries of the suite.
+ */
+std::vector<PerftSuiteEntry> loadPerftSuite() {
+	const std::string path = std::string(__FILE__).substr(0, std::string(__FILE__).find_last_of('/') + 1) +
+			"perftsuite.epd";
+	std::ifstream file(path);
+	std::vector<PerftSuiteEntry> entries;
+	std::string line;
+	while (std::getline(file, line)) {
+		PerftSuiteEntry entry;
+		if (parsePerftSuiteLine(line, entry)) entries.push_back(entry);
+	}
+	if (entries.empty()) std::cout << "Could not read the perft suite at " << path << '\n';
+	return entries;
+}
+
+void run_getFen_tests() {
+	int testNum = 0;
+	for (const PerftSuiteEntry& entry : loadPerftSuite())
+		assertEquals(GET_FEN, entry.fen, Position(entry.fen).getFen(), ++testNum);
+}
+
+/**
+ * @brief Count the moves that isLegal gets wrong in a position, out of every possible move encoding.
+ *
+ * @param position Position to check.
+ * @return Number of moves where isLegal disagrees with the generated moves.
+ */
+uint64_t countLegalityMismatches(Position& position) {
+	std::vector<bool> legal(1 << 16, false);
+	for (Move move : MoveList(position)) legal[move] = true;
+
+	uint64_t mismatches = 0;
+	for (uint move = 0; move < legal.size(); move++)
+		if (position.isLegal(static_cast<Move>(move)) != legal[move]) mismatches++;
+	return mismatches;
+}
+
+void run_isLegal_tests() {
+	// Every position of the suite and every position one move from it, which covers en-passant and castling rights.
+	int testNum = 0;
+	for (const PerftSuiteEntry& entry : loadPerftSuite()) {
+		Position position(entry.fen);
+		uint64_t mismatches = countLegalityMismatches(position);
+		for (Move move : MoveList(position)) {
+			position.processMakeMove(move);
+			mismatches += countLegalityMismatches(position);
+			position.processUndoMove();
+		}
+		assertEquals(LEGAL_MOVE, static_cast<uint64_t>(0), mismatches, ++testNum);
+	}
+}
+
+/**
+ * A network of small random weights, in the layout of the network file.
+ */
+struct RandomNetwork {
+	std::vector<int16_t> feature = std::vector<int16_t>(NNUE_INPUT_SIZE * NNUE_HIDDEN_SIZE);
+	std::vector<int16_t> bias = std::vector<int16_t>(NNUE_HIDDEN_SIZE);
+	std::vector<int16_t> output = std::vector<int16_t>(PLAYER_COUNT * NNUE_HIDDEN_SIZE);
+	int16_t outputBias = 0;
+
+	RandomNetwork() {
+		// Small enough that no accumulator can overflow, but large enough to be clipped at both ends.
+		std::mt19937 generator(20240101);
+		std::uniform_int_distribution<int> weight(-32, 32);
+		for (int16_t& value : this->feature) value = weight(generator);
+		for (int16_t& value : this->bias) value = weight(generator) * 4;
+		for (int16_t& value : this->output) value = weight(generator);
+		this->outputBias = weight(generator) * 16;
+	}
+
+	/**
+	 * @brief Write the network in the format read by NnueNetwork::load.
+	 *
+	 * @param path Path of the file to write.
+	 */
+	void write(const std::string& path) const {
+		std::ofstream file(path, std::ios::binary);
+		const uint32_t header[3] = {NNUE_VERSION, NNUE_INPUT_SIZE, NNUE_HIDDEN_SIZE};
+		file.write(reinterpret_cast<const char*>(header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(this->feature.data()), this->feature.size() * sizeof(int16_t));
+		file.write(reinterpret_cast<const char*>(this->bias.data()), this->bias.size() * sizeof(int16_t));
+		file.write(reinterpret_cast<const char*>(this->output.data()), this->output.size() * sizeof(int16_t));
+		file.write(reinterpret_cast<const char*>(&this->outputBias), sizeof(int16_t));
+	}
+
+	/**
+	 * @brief Run the output layer with plain loops, as a reference for the vectorised kernels.
+	 *
+	 * @param accumulator Accumulator of the position.
+	 * @param turn Player to move.
+	 * @return Evaluation in centipawns from the perspective of the player to move.
+	 */
+	int evaluate(const NnueAccumulator& accumulator, const Player turn) const {
+		int64_t sum = this->outputBias;
+		for (const Player perspective : {turn, static_cast<Player>(!turn)}) {
+			const int16_t* weights = this->output.data() + (perspective == turn ? 0 : NNUE_HIDDEN_SIZE);
+			for (uint index = 0; index < NNUE_HIDDEN_SIZE; index++)
+				sum += std::clamp<int64_t>(accumulator.values[perspective][index], 0, NNUE_QA) * weights[index];
+		}
+		return static_cast<int>(sum * NNUE_SCALE / (NNUE_QA * NNUE_QB));
+	}
+};
+
+/**
+ * @brief Check if the accumulator of a position matches one refreshed from its pieces.
+ *
+ * @param position Position to check.
+ * @return True if they match, else false.
+ */
+bool accumulatorMatchesRefresh(const Position& position) {
+	PieceType pieces[SQUARE_COUNT];
+	for (Square square = A1; square < SQUARE_COUNT; square++) pieces[square] = position.getPiece(square);
+	NnueAccumulator refreshed;
+	Nnue.refresh(refreshed, pieces);
+	const NnueAccumulator& accumulator = position.getAccumulator();
+	return std::equal(&accumulator.values[0][0], &accumulator.values[0][0] + PLAYER_COUNT * NNUE_HIDDEN_SIZE,
+			&refreshed.values[0][0]);
+}
+
+/**
+ * Positions of a walk where an incrementally updated term differs from a full recompute.
+ */
+struct IncrementalMismatches {
+	uint64_t evaluation = 0; // Material or piece square values.
+	uint64_t phase = 0;
+	uint64_t accumulator = 0; // Only compared while a network is loaded.
+};
+
+/**
+ * @brief Compare the incrementally updated terms of a position with the same position parsed from its FEN, and its
+ * accumulator with one refreshed from its pieces.
+ *
+ * @param position Position to check.
+ * @param fresh Scratch position to parse into.
+ * @param mismatches Counts of the terms that differ, which are incremented.
+ */
+void compareWithRecompute(const Position& position, Position& fresh, IncrementalMismatches& mismatches) {
+	fresh.parseFen(position.getFen());
+	mismatches.evaluation += position.getMaterial() != fresh.getMaterial() ||
+			position.getMiddlegamePsqt() != fresh.getMiddlegamePsqt() ||
+			position.getEndgamePsqt() != fresh.getEndgamePsqt();
+	mismatches.phase += position.getPhase() != fresh.getPhase();
+	if (Nnue.isLoaded()) mismatches.accumulator += !accumulatorMatchesRefresh(position);
+}
+
+/**
+ * @brief Make and undo every move to a depth, comparing each position reached (and each position restored by the
+ * undos) with a full recompute.
+ *
+ * @param position Position to walk from. Is restored before returning.
+ * @param fresh Scratch position to parse into.
+ * @param depth Depth to walk to.
+ * @param mismatches Counts of the terms that differ, which are incremented.
+ */
+void walkIncremental(Position& position, Position& fresh, const int depth, IncrementalMismatches& mismatches) {
+	compareWithRecompute(position, fresh, mismatches);
+	if (depth == 0) return;
+
+	for (Move move : MoveList(position)) {
+		position.processMakeMove(move);
+		walkIncremental(position, fresh, depth - 1, mismatches);
+		position.processUndoMove();
+	}
+	compareWithRecompute(position, fresh, mismatches);
+}
+
+void run_incremental_tests() {
+	// Positions only maintain their accumulators while a network is loaded, so one is loaded for the whole walk.
+	const RandomNetwork network;
+	const std::string path = (std::filesystem::temp_directory_path() / "sicario_test.nnue").string();
+	network.write(path);
+	const bool loaded = Nnue.load(path);
+	std::filesystem::remove(path);
+	if (!loaded) {
+		std::cout << "Could not load the test network from " << path << '\n';
+		return;
+	}
+
+	int testNum = 0;
+	Position fresh;
+	for (const PerftSuiteEntry& entry : loadPerftSuite()) {
+		Position position(entry.fen);
+		IncrementalMismatches mismatches;
+		walkIncremental(position, fresh, PERFT_SUITE_WALK_DEPTH, mismatches);
+		testNum++;
+		assertEquals(INCREMENTAL_EVALUATION, static_cast<uint64_t>(0), mismatches.evaluation, testNum);
+		assertEquals(INCREMENTAL_PHASE, static_cast<uint64_t>(0), mismatches.phase, testNum);
+		assertEquals(NNUE_ACCUMULATOR, static_cast<uint64_t>(0), mismatches.accumulator, testNum);
+
+		// Every move of the root, so that the output of the kernels is checked over many accumulators.
+		uint64_t evaluationMismatches = 0;
+		for (Move move : MoveList(position)) {
+			position.processMakeMove(move);
+			const int evaluation = Nnue.evaluate(position.getAccumulator(), position.getTurn());
+			if (evaluation != network.evaluate(position.getAccumulator(), position.getTurn())) evaluationMismatches++;
+			position.processUndoMove();
+		}
+		assertEquals(NNUE_EVALUATE, static_cast<uint64_t>(0), evaluationMismatches, testNum);
+	}
+	Nnue.unload();
+}
+
+void run_timeManager_tests() {
+	TimeManager timeManager;
+	const uint EXPAND_TIME = 100;
+
+	// A movetime sets both limits, less the overhead.
+	SearchLimits moveTime;
+	moveTime.moveTime = 1000;
+	timeManager.start(moveTime, WHITE, EXPAND_TIME);
+	assertEquals(TIME_MANAGER, true, timeManager.isTimed(), 1);
+	assertEquals(TIME_MANAGER, 1000 - MOVE_OVERHEAD, timeManager.getSoftLimit(), 2);
+	assertEquals(TIME_MANAGER, 1000 - MOVE_OVERHEAD, timeManager.getHardLimit(), 3);
+
+	// The clock of the player to move is split over the moves to go, and the hard limit is a multiple of the soft.
+	SearchLimits clock;
+	clock.clock[WHITE] = clock.clock[BLACK] = true;
+	clock.time[WHITE] = 60000;
+	clock.time[BLACK] = 30000;
+	timeManager.start(clock, BLACK, EXPAND_TIME);
+	assertEquals(TIME_MANAGER, static_cast<uint64_t>(30000 / DEFAULT_MOVES_TO_GO), timeManager.getSoftLimit(), 4);
+	assertEquals(TIME_MANAGER, 30000 / DEFAULT_MOVES_TO_GO * HARD_LIMIT_RATIO, timeManager.getHardLimit(), 5);
+	timeManager.start(clock, WHITE, 2 * EXPAND_TIME);
+	assertEquals(TIME_MANAGER, static_cast<uint64_t>(2 * 60000 / DEFAULT_MOVES_TO_GO), timeManager.getSoftLimit(),
+			6);
+
+	// With one move to go, the whole clock less the overhead is used.
+	SearchLimits lastMove = clock;
+	lastMove.movesToGo = 1;
+	timeManager.start(lastMove, WHITE, EXPAND_TIME);
+	assertEquals(TIME_MANAGER, 60000 - MOVE_OVERHEAD, timeManager.getSoftLimit(), 7);
+	assertEquals(TIME_MANAGER, 60000 - MOVE_OVERHEAD, timeManager.getHardLimit(), 8);
+
+	// An increment larger than the remaining time does not push the limits past the remaining time.
+	SearchLimits increment;
+	increment.clock[WHITE] = true;
+	increment.time[WHITE] = 500;
+	increment.increment[WHITE] = 2000;
+	timeManager.start(increment, WHITE, EXPAND_TIME);
+	assertEquals(TIME_MANAGER, 500 - MOVE_OVERHEAD, timeManager.getSoftLimit(), 9);
+	assertEquals(TIME_MANAGER, 500 - MOVE_OVERHEAD, timeManager.getHardLimit(), 10);
+
+	// An empty clock (the go command clamps negative times to zero) moves at once.
+	SearchLimits empty;
+	empty.clock[WHITE] = true;
+	timeManager.start(empty, WHITE, EXPAND_TIME);
+	assertEquals(TIME_MANAGER, true, timeManager.isTimed(), 11);
+	assertEquals(TIME_MANAGER, static_cast<uint64_t>(1), timeManager.getSoftLimit(), 12);
+	assertEquals(TIME_MANAGER, static_cast<uint64_t>(1), timeManager.getHardLimit(), 13);
+
+	// Only the clock of the player to move counts.
+	timeManager.start(empty, BLACK, EXPAND_TIME);
+	assertEquals(TIME_MANAGER, false, timeManager.isTimed(), 14);
+
+	// An infinite search has no time limits and only ends with the stop command.
+	SearchLimits infinite = clock;
+	infinite.infinite = true;
+	timeManager.start(infinite, WHITE, EXPAND_TIME);
+	assertEquals(TIME_MANAGER, false, timeManager.isTimed(), 15);
+	assertEquals(TIME_MANAGER, true, timeManager.isOpenEnded(), 16);
+
+	// A ponder search ignores its limits until the ponderhit, which starts its clock. The times are given rather than
+	// read, so the test does not depend on how fast it runs.
+	const SearchClock::time_point startTime = SearchClock::now();
+	const std::chrono::milliseconds ponderTime(50);
+	SearchLimits ponder = empty;
+	ponder.ponder = true;
+	timeManager.start(ponder, WHITE, EXPAND_TIME, startTime);
+	assertEquals(TIME_MANAGER, true, timeManager.isOpenEnded(), 17);
+	assertEquals(TIME_MANAGER, false, timeManager.hardLimitReached(startTime + ponderTime), 18);
+	timeManager.ponderHit(startTime + ponderTime);
+	assertEquals(TIME_MANAGER, false, timeManager.isOpenEnded(), 19);
+	assertEquals(TIME_MANAGER, static_cast<uint64_t>(0), timeManager.elapsed(startTime + ponderTime), 20);
+	assertEquals(TIME_MANAGER, false, timeManager.hardLimitReached(startTime + ponderTime), 21);
+	assertEquals(TIME_MANAGER, true, timeManager.hardLimitReached(startTime + ponderTime +
+			std::chrono::milliseconds(1)), 22);
+}
+
+/**
+ * @brief Describe a position by its FEN, hash and the length of its history, which a replay must all reproduce.
+ *
+ * @param position Position to describe.
+ * @return Description of the position.
+ */
+std::string describePosition(const Position& position) {
+	return position.getFen() + " hash " + std::to_string(position.getHash()) + " history " +
+			std::to_string(position.getHistory().size());
+}
+
+/**
+ * @brief Send a position command to an engine that has already been sent others, and to a new engine that replays the
+ * whole game from it.
+ *
+ * @param engine Engine that has been sent earlier position commands.
+ * @param command Position command to send.
+ * @return True if both engines end up in the same position, else false.
+ */
+bool matchesReplay(Sicario& engine, const std::string& command) {
+	engine.processInput(command);
+	Sicario replay;
+	replay.processInput(command);
+	return describePosition(engine.getPosition()) == describePosition(replay.getPosition());
+}
+
+void run_handlePosition_tests() {
+	const std::string KIWIPETE = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+	Sicario engine;
+
+	// Moves added to the end of the last command.
+	engine.processInput("position startpos moves e2e4");
+	assertEquals(POSITION_COMMAND, true, matchesReplay(engine, "position startpos moves e2e4 e7e5"), 1);
+	assertEquals(POSITION_COMMAND, true, matchesReplay(engine, "position startpos moves e2e4 e7e5 g1f3 b8c6"), 2);
+
+	// Takebacks, with and without a different move after them.
+	assertEquals(POSITION_COMMAND, true, matchesReplay(engine, "position startpos moves e2e4 e7e5"), 3);
+	assertEquals(POSITION_COMMAND, true, matchesReplay(engine, "position startpos moves e2e4 c7c5 g1f3"), 4);
+	assertEquals(POSITION_COMMAND, true, matchesReplay(engine, "position startpos"), 5);
+
+	// A changed start, including castling given as the king's move.
+	assertEquals(POSITION_COMMAND, true, matchesReplay(engine, "position fen " + KIWIPETE + " moves e1g1"), 6);
+	assertEquals(POSITION_COMMAND, std::string("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R4RK1 b kq - 1 1"),
+			engine.getPosition().getFen(), 7);
+	assertEquals(POSITION_COMMAND, true, matchesReplay(engine, "position fen " + KIWIPETE + " moves e1g1 e8c8"), 8);
+	assertEquals(POSITION_COMMAND, true, matchesReplay(engine, "position fen " + KIWIPETE + " moves e1c1 e8g8"), 9);
+	assertEquals(POSITION_COMMAND, true, matchesReplay(engine, "position startpos moves e2e4 e7e5"), 10);
+
+	// An illegal move stops the command there, and the next command replays the game.
+	assertEquals(POSITION_COMMAND, true, matchesReplay(engine, "position startpos moves e2e4 e7e5 e1e3"), 11);
+	assertEquals(POSITION_COMMAND, true, matchesReplay(engine, "position startpos moves e2e4 e7e5 g1f3"), 12);
+
+	// Positions repeated by the moves, which the history must hold for repetitions to be found.
+	const std::string shuffle = " g1f3 g8f6 f3g1 f6g8";
+	engine.processInput("position startpos moves" + shuffle);
+	assertEquals(POSITION_COMMAND, true, matchesReplay(engine, "position startpos moves" + shuffle + shuffle), 13);
+	assertEquals(POSITION_COMMAND, true, engine.getPosition().isDrawn(), 14);
+}
+
 void printFinalResult() {
 	std::cout << "\nPASSED: \033[0;32m" << std::to_string(TESTS_PASSED) << "\033[0m\t";
 	std::cout << "FAILED: \033[0;31m" << std::to_string(TESTS_FAILED) << "\033[0m\n";
@@ -745,6 +1209,12 @@ int main(int argc, char const *argv[]) {
 	run_whitePawnMagicNums_tests();
 	run_rookBlockMagicNums_tests();
 	run_bishopBlockMagicNums_tests();
+	run_isRepetition_tests();
+	run_getFen_tests();
+	run_incremental_tests();
+	run_timeManager_tests();
+	run_handlePosition_tests();
+	run_isLegal_tests();
 	printFinalResult();
 	return 0;
 }
\ No newline at end of file